@@ -0,0 +1,37 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef AFFINITY_H
+#define AFFINITY_H
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+// Ubicacion de procesos para corridas con tiempos reproducibles (master -c / -f).
+// Los procesos se numeran en orden de lanzamiento: master, vista (si hay), jugadores hijos y
+// jugadores externos. Cada uno va a una CPU de la lista (-c 0,2,3 ...; si es mas corta se
+// recorre de nuevo) o, con -c auto, a las CPUs permitidas repartidas en ronda.
+// -f prio los pasa a SCHED_FIFO con esa prioridad (necesita CAP_SYS_NICE; si falla se avisa y
+// se sigue con la politica normal).
+#define PLACE_MAX_CPUS 256
+
+typedef struct {
+    int  ncpus;                 // 0: sin afinidad
+    int  cpus[PLACE_MAX_CPUS];
+    int  fifo_prio;             // 0: sin SCHED_FIFO
+} placement_t;
+
+// "auto" o lista de CPUs separadas por coma. 0 o -1 si la lista es invalida
+int  placement_parse(placement_t *pl, const char *spec);
+
+// Valida la prioridad de SCHED_FIFO. 0 o -1 si esta fuera de rango
+int  placement_set_fifo(placement_t *pl, int prio);
+
+bool placement_enabled(const placement_t *pl);
+
+// Ubica al proceso pid (0 = este) en el lugar slot y lo informa por stderr como
+// "ubicacion: <who> pid=.. cpu=.. politica=..". 0 si se aplico todo lo pedido
+int  placement_apply(const placement_t *pl, pid_t pid, int slot, const char *who);
+
+#endif // AFFINITY_H
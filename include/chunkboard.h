@@ -0,0 +1,53 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef CHUNKBOARD_H
+#define CHUNKBOARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Tablero por bloques que se materializan al tocarlos.
+// Una celda nunca tocada vale engine_cell_reward(seed, y*W + x), igual que en el tablero denso,
+// asi que crear el tablero es O(1) y la memoria crece con el area explorada, no con W x H.
+// Coordenadas de 32 bits.
+#define CHUNK_SHIFT  6                         // bloques de 64 x 64 celdas
+#define CHUNK_SIDE   (1u << CHUNK_SHIFT)
+#define CHUNK_CELLS  (CHUNK_SIDE * CHUNK_SIDE)
+
+typedef struct chunk {
+    uint32_t      cx, cy;                      // coordenadas del bloque
+    struct chunk *next;                        // siguiente en el bucket (o en la lista libre)
+    int           cells[CHUNK_CELLS];
+} chunk_t;
+
+typedef struct {
+    uint32_t   width, height;
+    unsigned   seed;
+    chunk_t  **buckets;                        // tabla hash abierta por (cx, cy)
+    size_t     nbuckets;                       // potencia de 2
+    size_t     nchunks;                        // bloques materializados
+    chunk_t   *free_list;                      // bloques liberados por cb_reset, se reusan
+    chunk_t   *last;                           // ultimo bloque accedido (localidad de los jugadores)
+} chunkboard_t;
+
+// Crea un tablero W x H vacio. Devuelve 0 si ok, -1 si falla malloc
+int    cb_init(chunkboard_t *cb, uint32_t w, uint32_t h, unsigned seed);
+
+// Descarta lo materializado y cambia la semilla, sin devolver memoria (los bloques se reusan)
+void   cb_reset(chunkboard_t *cb, unsigned seed);
+
+// Valor de la celda (x,y): el guardado si el bloque existe, si no la recompensa procedural
+int    cb_get(chunkboard_t *cb, uint32_t x, uint32_t y);
+
+// Escribe la celda (x,y) materializando su bloque. Devuelve 0 si ok, -1 si falla malloc
+int    cb_set(chunkboard_t *cb, uint32_t x, uint32_t y, int v);
+
+// Memoria en uso por el tablero (bloques + tabla)
+size_t cb_bytes(const chunkboard_t *cb);
+
+// Libera todo
+void   cb_free(chunkboard_t *cb);
+
+#endif // CHUNKBOARD_H
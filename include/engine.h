@@ -0,0 +1,132 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sharedHeaders.h"
+#include "chunkboard.h"
+#include "padboard.h"
+
+// Reglas del juego sin IPC: las usa el master sobre la shm y el simulador sobre memoria propia.
+// Trabajan sobre un tablero W*H con el esquema de state_t.board y sobre player_t.
+
+// resultado de validar una jugada
+typedef enum {
+    MOVE_VALID = 0,
+    MOVE_BAD_DIR,          // byte fuera de 0..7
+    MOVE_OUT_OF_BOUNDS,    // destino fuera del tablero
+    MOVE_NOT_FREE          // destino ya capturado
+} move_result_t;
+
+// Valida mover al jugador en (x,y) hacia dir. Si es valida deja la celda destino en *idx
+move_result_t engine_check_move(const int *board, int W, int H, int x, int y, unsigned dir, int *idx);
+
+// Aplica una jugada ya validada: suma la recompensa, captura la celda como -id y mueve al jugador
+void engine_commit_move(int *board, int W, player_t *p, int id, int idx);
+
+// Cuenta una jugada invalida
+static inline void engine_reject_move(player_t *p){ p->inv_moves++; }
+
+// true si alguna celda vecina de (x,y) esta libre (si no, el jugador queda bloqueado)
+bool engine_has_valid_move(const int *board, int W, int H, int x, int y);
+
+// Celdas libres alcanzables desde (x,y) por celdas libres (sin contar (x,y)): el espacio que
+// le queda a un jugador. stack: W*H ints; seen: W*H bytes en 0, vuelven con lo visitado marcado
+int  engine_flood_count(const int *board, int W, int H, int x, int y, int *stack, uint8_t *seen);
+
+// Recompensa 1..9 de la celda idx (y*W + x) para una semilla: PRNG por contador (splitmix64),
+// no depende del orden en que se generan las celdas ni de cuantos hilos lo hacen
+static inline int engine_cell_reward(unsigned int seed, uint64_t idx){
+    uint64_t z = ((uint64_t)seed << 32 | 0x5EEDu) + (idx + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return 1 + (int)(((z >> 32) * 9u) >> 32);   // multiplicar y desplazar en vez de % 9
+}
+
+// Llena el tablero con recompensas 1..9 a partir de seed, repartiendo bloques de filas en
+// threads hilos (<= 0: automatico segun tamaño y CPUs). Mismo tablero para cualquier threads
+void engine_fill_board(int *board, int W, int H, unsigned int seed, int threads);
+
+// Posiciones iniciales parejas para n jugadores, con margen similar al borde
+void engine_distribute_positions(int n, int W, int H, int *px, int *py);
+
+// Marca la celda inicial de cada jugador como capturada (sin sumar score) y fija su posicion
+void engine_place_players(int *board, int W, player_t *players, int n, const int *px, const int *py);
+
+// Ganador: mayor score, luego mas validos, menos invalidos, menor pid. -1 si n == 0
+int  engine_winner(const player_t *players, int n);
+
+// ---- partidas en memoria ----
+
+// Partida completa sin procesos ni shm
+typedef struct {
+    int       width, height;
+    int       num_players;
+    int      *board;                   // W*H, se reusa entre partidas del mismo tamaño
+    padboard_t pad;                    // el mismo tablero con borde: las reglas miran vecinos aca
+    player_t  players[MAX_PLAYERS];
+    unsigned  rounds;                  // rondas jugadas
+    unsigned  moves;                   // jugadas procesadas (validas + invalidas)
+} engine_game_t;
+
+// Estrategia: devuelve la direccion elegida por el jugador me (cualquier byte, se valida igual)
+typedef int (*engine_strategy_fn)(const engine_game_t *g, int me, void *ctx);
+
+// Reserva el tablero (plano para las estrategias .so, con borde para las reglas).
+// Devuelve 0 si ok, -1 si falla malloc
+int  engine_game_init(engine_game_t *g, int W, int H, int nplayers);
+
+// Reinicia la partida: tablero nuevo segun seed, jugadores en cero y en posicion inicial
+void engine_game_reset(engine_game_t *g, unsigned int seed);
+
+// Juega por rondas (1 jugada por jugador activo) hasta que todos queden bloqueados
+// o pasen max_idle_rounds rondas seguidas sin jugadas validas (equivale al -t del master)
+void engine_game_play(engine_game_t *g, engine_strategy_fn strat[], void *ctx[], unsigned max_idle_rounds);
+
+// Libera el tablero
+void engine_game_free(engine_game_t *g);
+
+// ---- partidas sobre tablero por bloques (chunkboard.h) ----
+// Para mapas enormes con pocos jugadores: arranque O(1), memoria segun el area explorada
+// y coordenadas de 32 bits (player_t y la shm siguen limitados a unsigned short)
+
+typedef struct {
+    uint32_t x, y;
+    unsigned score, v_moves, inv_moves;
+    bool     blocked;
+} engine_cplayer_t;
+
+typedef struct {
+    chunkboard_t     board;
+    int              num_players;
+    engine_cplayer_t players[MAX_PLAYERS];
+    unsigned         rounds, moves;
+} engine_cgame_t;
+
+// No es const: leer una celda actualiza la cache de bloques del tablero
+typedef int (*engine_cstrategy_fn)(engine_cgame_t *g, int me, void *ctx);
+
+// Crea la partida (sin materializar nada). Devuelve 0 si ok, -1 si falla
+int  engine_cgame_init(engine_cgame_t *g, uint32_t W, uint32_t H, int nplayers);
+
+// Reinicia: descarta los bloques tocados y reubica a los jugadores. 0 si ok, -1 si no se pudo
+// materializar el bloque de alguna posicion inicial
+int  engine_cgame_reset(engine_cgame_t *g, unsigned int seed);
+
+// true si alguna celda vecina de (x,y) esta libre
+bool engine_cgame_has_valid_move(engine_cgame_t *g, uint32_t x, uint32_t y);
+
+// Mismas reglas y corte que engine_game_play
+void engine_cgame_play(engine_cgame_t *g, engine_cstrategy_fn strat[], void *ctx[], unsigned max_idle_rounds);
+
+// Ganador con los mismos criterios que engine_winner
+int  engine_cgame_winner(const engine_cgame_t *g);
+
+void engine_cgame_free(engine_cgame_t *g);
+
+#endif // ENGINE_H
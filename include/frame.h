@@ -0,0 +1,46 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <sys/types.h>
+#include "sharedHeaders.h"
+
+// Difusion de cuadros a espectadores (seccion EXT_SEC_FRAME de /game_ext).
+// El master marca cada seccion de escritor sobre /game_state con un epoch tipo seqlock
+// (impar mientras escribe). Los espectadores (view -s) copian el estado sin tomar el rwsem,
+// descartan la copia si el epoch cambio en el medio y duermen en un futex sobre el epoch.
+// El master solo hace un syscall de wake si hay alguien durmiendo, y es uno solo para todos:
+// su costo no depende de cuantos espectadores haya.
+typedef struct {
+    pid_t            master_pid;   // master que publica (un frame viejo no sirve)
+    _Atomic uint32_t epoch;        // par: estado estable; impar: el master esta escribiendo
+    _Atomic uint32_t waiters;      // espectadores dormidos en el futex
+} frame_t;
+
+// ---- master ----
+
+// Toma el frame para este master (un master anterior pudo morir con el epoch impar)
+void     frame_reset(frame_t *fr, pid_t master);
+
+// Dentro de la seccion de escritor
+void     frame_write_begin(frame_t *fr);
+void     frame_write_end(frame_t *fr);     // despierta a los espectadores dormidos
+
+// ---- espectador ----
+
+// Espera hasta timeout_ms a que el epoch deje de ser last. Devuelve el epoch actual
+uint32_t frame_wait(frame_t *fr, uint32_t last, int timeout_ms);
+
+// Copia el estado (header + tablero, size bytes) en dst sin lock. Si el master no deja una
+// ventana libre tras varios intentos, copia con el lock de lector de sy (con sy == NULL copia
+// igual sin lock: puede salir mezclada, sirve para monitores que no deben frenar al master).
+// Devuelve el epoch (par) de la copia
+uint32_t frame_snapshot(const frame_t *fr, const state_t *st, state_t *dst, size_t size, sync_t *sy);
+
+#endif // FRAME_H
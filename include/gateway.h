@@ -0,0 +1,53 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef GATEWAY_H
+#define GATEWAY_H
+
+#include <stdint.h>
+#include <sys/types.h>
+#include "sharedHeaders.h"
+
+// Jugadores externos por socket unix SOCK_SEQPACKET (master -u ruta -x n).
+// 1. el jugador se conecta y manda gw_hello_t con su nombre
+// 2. el master contesta gw_welcome_t con su indice y, por SCM_RIGHTS, los fds de
+//    /game_state (solo lectura), /game_sync y /game_ext (si existe)
+// 3. desde ahi el protocolo es el mismo que por pipe: esperar G[i] y mandar la direccion.
+//    Un mensaje puede traer varias direcciones (hasta GW_MAX_BATCH); se atienden de a una
+#define GW_MAGIC      0x504D4843u     // "CHMP"
+#define GW_VERSION    2u              // 2: el tercer fd es /game_ext (antes /game_log)
+#define GW_MAX_BATCH  64
+#define GW_NFDS       3               // state, sync, ext
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    char     name[NAME_LEN];
+} gw_hello_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    int32_t  index;                   // -1: rechazado (sin lugar o version distinta)
+    int32_t  master_pid;              // para validar el log como hace el jugador hijo
+    uint16_t width, height;
+    uint32_t nfds;                    // fds que vienen con el mensaje (2 o 3)
+} gw_welcome_t;
+
+// ---- lado master ----
+
+// Crea el socket en path (borra uno viejo) y lo deja escuchando. fd o -1
+int  gw_listen(const char *path);
+
+// Espera un jugador hasta timeout_ms y lo registra en el lugar index.
+// Devuelve el fd conectado, con su nombre y el pid del otro extremo (SO_PEERCRED); -1 si falla
+int  gw_accept(int lfd, int index, unsigned short W, unsigned short H, int timeout_ms,
+               char name[NAME_LEN], pid_t *pid);
+
+// ---- lado jugador ----
+
+// Se conecta, se registra y recibe los fds (fds[2] = -1 si no hay /game_ext). fd conectado o -1
+int  gw_join(const char *path, const char *name, gw_welcome_t *wl, int fds[GW_NFDS]);
+
+#endif // GATEWAY_H
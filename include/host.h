@@ -0,0 +1,31 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef HOST_H
+#define HOST_H
+
+// Master multipartida (master -n): un solo proceso lleva muchas partidas independientes a la
+// vez, sin vista. Cada partida k tiene sus propios segmentos (/game_state.k y /game_sync.k, ver
+// IPC_GAME_ENV en ipc.h), su tablero, sus compuertas G[i] y su timeout; sus jugadores se lanzan
+// con CHOMP_GAME=k y no notan la diferencia. Las partidas se reparten entre hilos (-j): cada hilo
+// hace poll sobre los pipes de todas sus partidas y las avanza, asi el costo de un master por
+// partida (proceso, select, cambios de contexto) se paga una vez por hilo.
+#define HOST_MAX_GAMES   4096
+#define HOST_MAX_WORKERS 64
+
+typedef struct {
+    unsigned short width, height;
+    int      ngames;            // partidas simultaneas
+    int      nworkers;          // hilos que las atienden
+    int      nplayers;          // jugadores por partida
+    char   **players;           // binario de cada jugador
+    int      timeout_s;         // sin jugadas validas en una partida: se termina (0 = sin timeout)
+    unsigned seed;              // la partida k usa seed + k
+} host_cfg_t;
+
+// Lanza todas las partidas, las juega hasta el final, espera a los jugadores, informa un
+// resumen por stdout y borra los segmentos. 0 si ok, -1 si no se pudo arrancar ninguna
+int host_run(const host_cfg_t *cfg);
+
+#endif // HOST_H
@@ -8,6 +8,24 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include "sharedHeaders.h"
+#include "movelog.h"
+#include "frame.h"
+#include "lockstats.h"
+#include "lockwatch.h"
+#include "zobrist.h"
+#include "shmext.h"
+
+// Partida elegida: con CHOMP_GAME=id en el entorno (o ipc_set_game) los segmentos pasan a ser
+// /game_state.id, /game_sync.id y /game_ext.id. Asi un master multipartida (host.h) tiene
+// varias partidas a la vez y cada jugador, vista o shm_tool se engancha a la suya sin cambios.
+// Sin id se usan los nombres de siempre (los de la catedra)
+#define IPC_GAME_ENV "CHOMP_GAME"
+
+// Cambia la partida de este proceso (NULL o "" vuelve a los nombres sin sufijo)
+void ipc_set_game(const char *id);
+
+// Nombre real del segmento base (SHM_STATE, SHM_SYNC o SHM_EXT) para la partida actual
+const char *ipc_shm_name(const char *base);
 
 // Tamaño real de /game_state según W x H
 size_t ipc_state_size(unsigned short width, unsigned short height);
@@ -19,7 +37,11 @@ state_t* ipc_create_and_map_state(unsigned short w, unsigned short h, bool *exis
 // Abre /game_state existente y la mapea (RW, MAP_SHARED)
 state_t* ipc_open_and_map_state(void);
 
-// Desmapea /game_state
+// Mapea /game_state desde un fd (por ejemplo recibido por SCM_RIGHTS) y lo cierra.
+// writable=false mapea solo lectura (fd abierto O_RDONLY)
+state_t* ipc_map_state_fd(int fd, bool writable);
+
+// Desmapea /game_state (con el tamaño con que se mapeo en este proceso)
 void ipc_unmap_state(state_t *st);
 
 // Elimina /game_state
@@ -33,6 +55,9 @@ sync_t* ipc_create_and_map_sync(bool *created);
 // Abre /game_sync existente
 sync_t* ipc_open_and_map_sync(void);
 
+// Mapea /game_sync desde un fd abierto O_RDWR y lo cierra
+sync_t* ipc_map_sync_fd(int fd);
+
 // Desmapea /game_sync
 void ipc_unmap_sync(sync_t *sy);
 
@@ -42,10 +67,30 @@ int ipc_unlink_sync(void);
 // Inicializa todos los semáforos de sync_t con pshared=1
 int ipc_init_sync_semaphores(sync_t *sy);
 
-// Limpia ambos: shm_unlink de /game_state y /game_sync
+// ---- /game_ext ----
+
+// Crea /game_ext desde cero (borra uno anterior) con las n secciones pedidas (id y tamaño;
+// el offset lo asigna el arena) en 0, y la mapea (RW)
+ext_header_t* ipc_create_and_map_ext(const ext_section_t *want, unsigned n);
+
+// Abre /game_ext existente y valida el header. NULL si no existe (master de la catedra) o si
+// el formato no es el esperado (errno = EPROTO)
+ext_header_t* ipc_open_and_map_ext(bool writable);
+
+// Igual, desde un fd (por ejemplo recibido por SCM_RIGHTS), que se cierra
+ext_header_t* ipc_map_ext_fd(int fd, bool writable);
+
+// Desmapea /game_ext
+void ipc_unmap_ext(const ext_header_t *h);
+
+// Elimina /game_ext
+int ipc_unlink_ext(void);
+
+// Limpia todas: shm_unlink de /game_state, /game_sync y /game_ext
 static inline void ipc_unlink_all(void) {
     ipc_unlink_state();
     ipc_unlink_sync();
+    ipc_unlink_ext();
 }
 
 #endif // CHOMP_IPC_H
\ No newline at end of file
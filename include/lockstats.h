@@ -0,0 +1,37 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef LOCKSTATS_H
+#define LOCKSTATS_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sys/types.h>
+
+// Contadores del lock de escritor (seccion EXT_SEC_STATS de /game_ext).
+// Los escribe solo el master alrededor de cada seccion de escritor; shm_tool top los lee
+// sin lock para mostrar contencion sin sumar lectores al rwsem.
+typedef struct {
+    pid_t            master_pid;
+    uint64_t         started_ns;           // CLOCK_MONOTONIC al arrancar el master
+    _Atomic uint64_t writer_sections;      // secciones de escritor
+    _Atomic uint64_t writer_contended;     // de esas, cuantas encontraron lectores adentro
+    _Atomic uint64_t writer_wait_ns;       // tiempo total esperando el lock de escritor
+    _Atomic uint64_t writer_max_wait_ns;   // peor espera
+} lockstats_t;
+
+// Solo el master escribe: alcanza con load + store relajados
+static inline void lockstats_add(_Atomic uint64_t *c, uint64_t v){
+    atomic_store_explicit(c, atomic_load_explicit(c, memory_order_relaxed) + v, memory_order_relaxed);
+}
+
+static inline void lockstats_record(lockstats_t *ls, uint64_t wait_ns, int contended){
+    lockstats_add(&ls->writer_sections, 1u);
+    if (contended) lockstats_add(&ls->writer_contended, 1u);
+    lockstats_add(&ls->writer_wait_ns, wait_ns);
+    if (wait_ns > atomic_load_explicit(&ls->writer_max_wait_ns, memory_order_relaxed))
+        atomic_store_explicit(&ls->writer_max_wait_ns, wait_ns, memory_order_relaxed);
+}
+
+#endif // LOCKSTATS_H
@@ -0,0 +1,78 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef LOCKWATCH_H
+#define LOCKWATCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sys/types.h>
+#include "sharedHeaders.h"
+
+// Dueños del rwsem (seccion EXT_SEC_LOCKWATCH de /game_ext). Los semaforos de sync_t no saben
+// quien los tiene, asi que un lector que muere con C, E o D tomado traba al master para siempre.
+// Cada lector ocupa un lugar con su pid y anota en que paso del protocolo esta (rwsem.h) y si
+// esta contado en F. El master espera con timeout y, si vence, busca lugares de procesos
+// muertos: se queda con el semaforo que quedo tomado, descuenta de F a los lectores muertos,
+// libera D si ya no queda ninguno y lo informa. Lo mismo cuando un jugador se cae (eof). Sin /game_ext (master de la catedra) los lectores no anotan nada.
+#define LW_SLOTS       32
+#define LW_TIMEOUT_MS  100      // espera del master antes de revisar dueños
+
+// paso del protocolo en que esta el lector (WAIT: bloqueado o recien entrado, HOLD: lo tiene)
+enum {
+    LW_OUT = 0,
+    LW_WAIT_C, LW_HOLD_C,
+    LW_WAIT_E, LW_HOLD_E,
+    LW_READ,                    // adentro, con el lock de lector
+};
+
+// Un jugador externo (gateway.h) puede correr en otro espacio de pids: su getpid() no le dice
+// nada al master. Anota en peer su indice + 1 y el master lo verifica con el pid que le dio
+// SO_PEERCRED al registrarlo (peer_pid). Mientras ese pid no este, el lugar no se puede
+// verificar y se lo da por vivo: nunca se le descuenta nada a un lector que puede estar adentro
+typedef struct {
+    _Atomic pid_t    pid;       // 0: libre (de un externo, pid en su espacio: solo marca el lugar)
+    _Atomic uint32_t phase;
+    _Atomic uint32_t counted;   // 1 mientras este proceso esta sumado en F
+    _Atomic int32_t  peer;      // 0: pid propio; i + 1: jugador externo i
+} lw_slot_t;
+
+typedef struct {
+    pid_t            master_pid;
+    _Atomic uint32_t recoveries;        // semaforos liberados o lectores descontados
+    _Atomic pid_t    peer_pid[MAX_PLAYERS];     // jugadores externos, segun SO_PEERCRED
+    lw_slot_t        slots[LW_SLOTS];
+} lockwatch_t;
+
+// lugar de este proceso (NULL: sin vigilancia)
+extern lw_slot_t *lw_self;
+
+static inline void lw_phase(uint32_t phase){
+    if (lw_self) atomic_store(&lw_self->phase, phase);
+}
+
+static inline void lw_counted(uint32_t c){
+    if (lw_self) atomic_store(&lw_self->counted, c);
+}
+
+// ---- lectores ----
+
+// Toma un lugar libre (o el de un proceso muerto que no dejo nada tomado). peer es el indice
+// de jugador si se entro por el gateway, -1 si no. -1 si no hay lugar
+int  lockwatch_attach(lockwatch_t *w, int peer);
+
+// ---- master ----
+
+// Pid (visto desde el master) del jugador externo i, para verificar su lugar
+void lockwatch_set_peer(lockwatch_t *w, int i, pid_t pid);
+
+// Entrada de escritor que no se traba por un lector muerto (con w == NULL es rw_writer_enter)
+void lockwatch_writer_enter(sync_t *sy, lockwatch_t *w);
+
+// Limpia lo que haya dejado un lector muerto (E tomado, F de mas, D sin dueño) aunque el
+// master no este esperando el lock: los lectores vivos tambien se trabarian. Sin locks tomados
+void lockwatch_sweep(sync_t *sy, lockwatch_t *w);
+
+#endif // LOCKWATCH_H
@@ -0,0 +1,29 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <stdint.h>
+#include "mirror.h"
+
+// Busqueda Monte Carlo (MCTS) multi-hilo para el jugador.
+// Un pool de hilos fijo comparte un arbol sin locks (contadores atomicos y expansion por CAS),
+// los rollouts pendientes se reparten con colas por hilo y robo de trabajo.
+typedef struct mcts mcts_t;
+
+// Crea el pool con nthreads hilos (incluye al hilo que llama) para un tablero W x H
+mcts_t* mcts_create(int nthreads, unsigned short w, unsigned short h);
+
+// Busca sobre la copia local hasta deadline_ns (CLOCK_MONOTONIC).
+// Devuelve la direccion 0..7, o -1 si el jugador no tiene movimientos
+int mcts_search(mcts_t *mc, const mirror_t *m, int me, uint64_t deadline_ns);
+
+// Imprime en stderr los rollouts/s acumulados (stdout es el pipe del master)
+void mcts_report(const mcts_t *mc, int me);
+
+// Detiene los hilos y libera todo
+void mcts_destroy(mcts_t *mc);
+
+#endif // MCTS_H
@@ -0,0 +1,36 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef MIRROR_H
+#define MIRROR_H
+
+#include <stdbool.h>
+#include "sharedHeaders.h"
+#include "movelog.h"
+
+// Copia privada del tablero que mantiene cada jugador.
+// Con el log de /game_ext disponible solo aplica los registros nuevos desde la ultima lectura,
+// sin log (master de la catedra) copia el tablero completo en cada sincronizacion.
+typedef struct {
+    int                width, height;
+    int               *board;          // W*H celdas, mismo esquema que st->board
+    player_t           players[MAX_PLAYERS];
+    unsigned int       num_players;
+    bool               valid;          // false hasta la primera copia completa
+    unsigned int       game_id;        // game_id del log al sincronizar
+    unsigned long long seq;            // proximo registro del log a aplicar
+    unsigned long long full_syncs;     // copias completas realizadas
+    unsigned long long applied;        // registros aplicados incrementalmente
+} mirror_t;
+
+// Reserva la copia para un tablero W x H. Devuelve 0 si ok, -1 si falla malloc
+int  mirror_init(mirror_t *m, unsigned short w, unsigned short h);
+
+// Actualiza la copia desde la shm. Llamar con lock de lector tomado. lg puede ser NULL
+void mirror_sync(mirror_t *m, const state_t *st, const movelog_t *lg);
+
+// Libera la copia
+void mirror_free(mirror_t *m);
+
+#endif // MIRROR_H
@@ -0,0 +1,50 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef MOVELOG_H
+#define MOVELOG_H
+
+#include "sharedHeaders.h"
+
+// Log de movimientos (seccion EXT_SEC_LOG de /game_ext): el master de la catedra no lo crea.
+// El master agrega un registro por cada captura dentro de su seccion de escritor,
+// los jugadores lo leen con el lock de lector y aplican solo lo nuevo a su copia local.
+#define MOVELOG_CAP    4096            // potencia de 2, registros en el anillo
+
+typedef struct {
+    unsigned int   idx;                // celda capturada (y*W + x)
+    unsigned int   owner;              // jugador que la capturo (la celda pasa a -owner)
+    unsigned short pos_x;              // posicion del jugador luego del movimiento
+    unsigned short pos_y;
+} move_rec_t;
+
+typedef struct {
+    pid_t              master_pid;     // master que lo publica (un log viejo no sirve)
+    unsigned short     width;          // tablero al que corresponde el log
+    unsigned short     height;
+    unsigned int       game_id;        // cambia en cada partida, obliga a resincronizar
+    unsigned long long head;           // secuencia del proximo registro (monotona)
+    move_rec_t         recs[MOVELOG_CAP];
+} movelog_t;
+
+// Reinicia el log para una partida nueva (llamar con lock de escritor)
+static inline void movelog_reset(movelog_t *lg, pid_t master, unsigned short w, unsigned short h){
+    lg->master_pid = master;
+    lg->width = w;
+    lg->height = h;
+    lg->game_id++;
+    lg->head = 0;
+}
+
+// Publica una captura (llamar con lock de escritor)
+static inline void movelog_push(movelog_t *lg, int idx, int owner, int x, int y){
+    move_rec_t *r = &lg->recs[lg->head & (MOVELOG_CAP - 1)];
+    r->idx   = (unsigned int)idx;
+    r->owner = (unsigned int)owner;
+    r->pos_x = (unsigned short)x;
+    r->pos_y = (unsigned short)y;
+    lg->head++;
+}
+
+#endif // MOVELOG_H
@@ -0,0 +1,60 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef PADBOARD_H
+#define PADBOARD_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include "sharedHeaders.h"
+
+// Tablero con un borde de una celda de centinelas (PAD_WALL, nunca libre) alrededor del
+// W x H. Los vecinos de cualquier celda del tablero existen siempre, asi que mirar los 8 es
+// sumar un desplazamiento precalculado y leer, sin in_bounds ni y*W + x por vecino.
+// Es una copia privada: /game_state sigue plano (formato de la catedra) y vista y jugadores
+// no ven el borde. Los indices son relativos a cells: (x,y) -> y*stride + x (ver padboard_idx)
+#define PAD_WALL INT_MIN
+
+typedef struct {
+    int  width, height;
+    int  stride;                // width + 2
+    int *mem;                   // (width + 2) x (height + 2)
+    int *cells;                 // mem + stride + 1: la celda (0,0)
+    int  nb[8];                 // desplazamiento de cada direccion (DX/DY)
+} padboard_t;
+
+// Reserva el tablero con el borde ya puesto. 0 si ok, -1 si falla malloc
+int  padboard_init(padboard_t *b, int W, int H);
+
+// Copia un tablero plano W*H (el de state_t) al interior
+void padboard_load(padboard_t *b, const int *flat);
+
+void padboard_free(padboard_t *b);
+
+static inline int padboard_idx(const padboard_t *b, int x, int y){ return y * b->stride + x; }
+static inline int padboard_x(const padboard_t *b, int i){ return i % b->stride; }   // solo interior
+static inline int padboard_y(const padboard_t *b, int i){ return i / b->stride; }
+
+// Indice en el tablero plano W*H de una celda del interior
+static inline int padboard_flat(const padboard_t *b, int i){
+    return idx_xy(padboard_x(b, i), padboard_y(b, i), b->width);
+}
+
+// true si algun vecino de i esta libre: 8 lecturas y un OR, sin saltos (vectorizable)
+static inline bool padboard_has_valid_move(const padboard_t *b, int i){
+    const int *c = b->cells + i;
+    int any = 0;
+    for (int d = 0; d < 8; ++d) any |= (c[b->nb[d]] > 0);
+    return any != 0;
+}
+
+// Celda destino de mover desde i hacia dir si esta libre, -1 si no (direccion invalida,
+// borde o capturada)
+static inline int padboard_target(const padboard_t *b, int i, unsigned dir){
+    if (dir > 7) return -1;
+    int j = i + b->nb[dir];
+    return (b->cells[j] > 0) ? j : -1;
+}
+
+#endif // PADBOARD_H
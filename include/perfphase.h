@@ -0,0 +1,57 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef PERFPHASE_H
+#define PERFPHASE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Contadores de hardware por fase del bucle del master (master -P), con perf_event_open.
+// Un solo grupo (ciclos, instrucciones, cache misses, branch misses y cambios de contexto) que se
+// lee con un read en cada cambio de fase: lo contado desde el cambio anterior se suma a la fase
+// que terminaba. Los contadores que el kernel o la maquina no dan (VM, perf_event_paranoid) quedan
+// como no disponibles y se sigue con el resto.
+typedef enum {
+    PH_WAIT = 0,        // select y delay entre impresiones
+    PH_VALIDATE,        // leer la jugada, validarla y rehabilitar G[i]
+    PH_WRITER,          // seccion de escritor (espera del lock incluida)
+    PH_REPAINT,         // ida y vuelta A/B con la vista
+    PH_BLOCKED,         // deteccion de jugadores bloqueados y fin de partida
+    PH_COUNT
+} phase_t;
+
+typedef enum { PC_CYCLES = 0, PC_INSTR, PC_CACHE_MISS, PC_BRANCH_MISS, PC_CTX_SW, PC_COUNT } pcounter_t;
+
+typedef struct {
+    int      leader;                        // fd del lider del grupo, -1 si no hay contadores
+    int      fd[PC_COUNT];                  // -1: no disponible
+    int      slot[PC_COUNT];                // posicion de cada contador en la lectura del grupo
+    int      nopen;
+    phase_t  cur;
+    uint64_t last[PC_COUNT];                // lectura del ultimo cambio de fase
+    uint64_t total[PH_COUNT][PC_COUNT];
+    uint64_t moves;                         // jugadas leidas (promedios por jugada)
+    bool     multiplexed;                   // el kernel no los tuvo siempre en la PMU
+    bool     paused;                        // parados: lo que pase no es de ninguna fase
+} perfphase_t;
+
+// Abre los contadores de este proceso. 0 si abrio al menos uno, -1 (con errno) si ninguno
+int  perfphase_open(perfphase_t *pp);
+
+// Cierra la fase actual y pasa a ph. Devuelve la fase que termino (para volver con otro cambio)
+phase_t perfphase_switch(perfphase_t *pp, phase_t ph);
+
+// Cierra la fase actual y para el grupo (fin del bucle, preparacion entre partidas)
+void perfphase_pause(perfphase_t *pp);
+
+// Vuelve a contar desde ahora, en la fase ph. Sin efecto si no estaba en pausa
+void perfphase_resume(perfphase_t *pp, phase_t ph);
+
+// Totales y promedios por jugada de cada fase, por stdout
+void perfphase_report(perfphase_t *pp);
+
+void perfphase_close(perfphase_t *pp);
+
+#endif // PERFPHASE_H
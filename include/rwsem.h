@@ -4,6 +4,7 @@
 
 #pragma once
 #include "sharedHeaders.h"
+#include "lockwatch.h"
 
 // Readers-writers with turnstile to avoid writer starvation.
 // Semaphores in sync_t used:
@@ -16,31 +17,43 @@
 // Los lectores que ya estaban adentro terminan normal, se contabilizan con F.
 // El primer lector en entrar toma D para bloquear escritores, el ultimo lector en salir libera D.
 // El orden C -> D al entrar escritor, y D -> C al salir, evita deadlock.
+// Los lw_* anotan en /game_ext en que paso esta el lector, para que el master pueda liberar
+// lo que deje tomado si muere adentro (ver lockwatch.h); sin vigilancia no hacen nada.
 
 
 static inline void rw_reader_enter(sync_t *sy){
     // C: acceso ordenado, si un escritor tomo C (sem_wait), el lector espera
+    lw_phase(LW_WAIT_C);
     sem_wait(&sy->C);
+    lw_phase(LW_HOLD_C);
     sem_post(&sy->C); // Inmediatamente libera C para que otros lectores entren
 
     // E/F: protege y actualiza la cantidad de lectores activos
+    lw_phase(LW_WAIT_E);
     sem_wait(&sy->E);
+    lw_phase(LW_HOLD_E);
     sy->F++;
+    lw_counted(1u);
     if (sy->F == 1) {
         // Primer lector, toma D para bloquear a los escritores
         sem_wait(&sy->D);
     }
+    lw_phase(LW_READ);
     sem_post(&sy->E);
 }
 
 static inline void rw_reader_exit(sync_t *sy){
     // Actualiza F con exclusion y, si es el ultimo, libera a los escritores D
+    lw_phase(LW_WAIT_E);
     sem_wait(&sy->E);
+    lw_phase(LW_HOLD_E);
     if (sy->F > 0) sy->F--; // F no debe ser negativo
+    lw_counted(0u);
     if (sy->F == 0) {
         // el ultimo lector permite escritores
         sem_post(&sy->D);
     }
+    lw_phase(LW_OUT);
     sem_post(&sy->E);
 }
 
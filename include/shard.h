@@ -0,0 +1,68 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef SHARD_H
+#define SHARD_H
+
+#include <stdbool.h>
+#include "engine.h"
+
+// Partidas con cientos de jugadores sobre un tablero denso, aplicadas por varios hilos.
+// El tablero se parte en baldosas de 2^SHARD_TILE_SHIFT de lado y cada baldosa tiene un hilo
+// dueño. Cada ronda tiene tres fases separadas por barreras:
+//   1. cada jugador activo elige direccion sobre el tablero del inicio de la ronda (solo lectura,
+//      los jugadores se reparten en bloques entre los hilos)
+//   2. cada jugada la aplica el dueño de la baldosa de su celda destino, en orden de id; en la
+//      fase 1 cada hilo ya las deja en un balde por dueño, asi el dueño solo recorre las suyas
+//   3. se decide si sigue la partida
+// Una captura solo escribe la celda destino y al propio jugador, asi que jugadas con destino en
+// baldosas distintas nunca se pisan: no hay lock ni coordinacion entre baldosas. Dos jugadas al
+// mismo destino caen en la misma baldosa y se la queda el de menor id. El resultado es el mismo
+// que aplicar en serie, en orden de id, las jugadas elegidas al inicio de la ronda, y no depende
+// de la cantidad de hilos.
+#define SHARD_TILE_SHIFT   6               // baldosas de 64 x 64
+#define SHARD_MAX_THREADS  64
+
+typedef struct {
+    int      x, y;
+    unsigned score, v_moves, inv_moves;
+    bool     blocked;
+    int      dest;                         // celda elegida en la ronda (-1 = ninguna o invalida)
+} shard_player_t;
+
+typedef struct shard_game shard_game_t;
+struct shard_pool;
+
+// Estrategia: devuelve la direccion del jugador me. Corre en paralelo con las de otros
+// jugadores, solo puede leer el tablero y escribir en su ctx
+typedef int (*shard_strategy_fn)(const shard_game_t *g, int me, void *ctx);
+
+struct shard_game {
+    int                width, height;
+    int                num_players;
+    int                nthreads;
+    int               *board;              // mismo esquema que state_t.board (libre 1..9, capturada -id)
+    shard_player_t    *players;
+    unsigned           rounds;
+    unsigned long long moves;
+    struct shard_pool *pool;               // hilos persistentes, privado de shard.c
+};
+
+// Reserva tablero, jugadores y nthreads-1 hilos (el que llama es el hilo 0). 0 si ok, -1 (con
+// errno) si falla; en ese caso no queda nada reservado ni ningun hilo corriendo
+int  shard_game_init(shard_game_t *g, int W, int H, int nplayers, int nthreads);
+
+// Tablero nuevo segun seed (engine_fill_board) y jugadores repartidos con engine_distribute_positions.
+// 0 si ok, -1 si falla malloc (el tablero no se toca)
+int  shard_game_reset(shard_game_t *g, unsigned int seed);
+
+// Juega hasta que todos queden bloqueados o pasen max_idle_rounds rondas sin jugadas validas
+void shard_game_play(shard_game_t *g, shard_strategy_fn strat[], void *ctx[], unsigned max_idle_rounds);
+
+// Mas puntaje, mas validas, menos invalidas, menor id. -1 si no hay jugadores
+int  shard_game_winner(const shard_game_t *g);
+
+void shard_game_free(shard_game_t *g);
+
+#endif // SHARD_H
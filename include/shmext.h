@@ -0,0 +1,61 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef SHMEXT_H
+#define SHMEXT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <sys/types.h>
+
+// Arena de extensiones propias (SHM_EXT). /game_state y /game_sync tienen el formato fijo de
+// la catedra; todo lo demas (log, frames, contadores, ...) vive en un solo segmento que se
+// describe a si mismo: un header con magic, version y una tabla de secciones (id, offset,
+// tamaño) alineadas a linea de cache. Quien se engancha valida el header y busca las secciones
+// por id: las que no conoce las ignora y las que faltan las trata como ausentes, asi agregar
+// una seccion nueva no rompe binarios viejos. Un mapeo por proceso para todas las extensiones.
+#define SHM_EXT            "/game_ext"
+#define EXT_MAGIC          0x54584843u     // "CHXT"
+#define EXT_VERSION        1u              // cambia solo si cambia el header (no por secciones nuevas)
+#define EXT_ALIGN          64u             // linea de cache: dos secciones nunca comparten linea
+#define EXT_MAX_SECTIONS   16
+
+// ids de seccion (no se reusan: el id de una seccion retirada no se vuelve a asignar)
+enum {
+    EXT_SEC_LOG       = 1,  // movelog_t   (movelog.h)
+    EXT_SEC_FRAME     = 2,  // frame_t     (frame.h)
+    EXT_SEC_STATS     = 3,  // lockstats_t (lockstats.h)
+    EXT_SEC_LOCKWATCH = 4,  // lockwatch_t (lockwatch.h)
+    EXT_SEC_ZOBRIST   = 5,  // zobrist_t   (zobrist.h)
+};
+
+typedef struct {
+    uint32_t id;
+    uint32_t _pad;
+    uint64_t offset;        // desde el inicio del segmento, multiplo de EXT_ALIGN
+    uint64_t size;
+} ext_section_t;
+
+typedef struct {
+    _Atomic uint32_t magic;         // se publica ultimo: con magic valido el resto esta escrito
+    uint32_t         version;
+    uint32_t         header_size;   // sizeof(ext_header_t) de quien lo creo
+    uint32_t         nsections;
+    uint64_t         total_size;    // bytes mapeados
+    pid_t            master_pid;    // master que lo creo
+    ext_section_t    sections[EXT_MAX_SECTIONS];
+} ext_header_t;
+
+// Seccion id con al menos min_size bytes (una version vieja de la seccion no sirve). NULL si no esta
+static inline void *ext_section(const ext_header_t *h, uint32_t id, size_t min_size){
+    if (!h) return NULL;
+    for (uint32_t i = 0; i < h->nsections; ++i){
+        const ext_section_t *s = &h->sections[i];
+        if (s->id == id) return (s->size >= min_size) ? (char*)h + s->offset : NULL;
+    }
+    return NULL;
+}
+
+#endif // SHMEXT_H
@@ -0,0 +1,77 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef SPINWAIT_H
+#define SPINWAIT_H
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <semaphore.h>
+#include <unistd.h>
+
+// Espera adaptativa para los pasamanos G[i], A y B: antes de dormir en sem_wait se reintenta
+// sem_trywait unas vueltas con pause. El contador del sem_t es la palabra compartida (sync_t
+// tiene el formato fijo de la catedra, no hay lugar para otra): si el post llega durante el
+// giro, ni el que espera duerme ni el que postea hace el FUTEX_WAKE (glibc solo lo hace si hay
+// alguien dormido). El presupuesto se adapta: sube cuando el giro acierta y se achica a la
+// mitad cuando no alcanza, asi un lado que siempre tarda deja de quemar CPU.
+// CHOMP_SPIN=n fija el tope de vueltas (0 o sin variable: sem_wait de siempre). Con una sola
+// CPU no se gira nunca: el que tiene que postear no puede correr mientras giramos.
+#define SPIN_MIN 16
+
+typedef struct {
+    unsigned           max;        // tope de vueltas (0 = deshabilitado)
+    unsigned           avg;        // estimacion de vueltas hasta el post
+    unsigned long long hits;       // esperas resueltas girando
+    unsigned long long sleeps;     // esperas que terminaron en sem_wait
+    unsigned long long spins;      // vueltas totales
+} spinwait_t;
+
+static inline void cpu_relax(void){
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static inline void spinwait_init(spinwait_t *sw){
+    const char *s = getenv("CHOMP_SPIN");
+    long max = s ? atol(s) : 0;
+    if (max < 0 || sysconf(_SC_NPROCESSORS_ONLN) < 2) max = 0;
+    *sw = (spinwait_t){ .max = (unsigned)max, .avg = 0 };
+}
+
+// Como sem_wait: 0, o -1 con errno (EINTR incluido, el llamador decide si reintenta)
+static inline int spinwait_sem(spinwait_t *sw, sem_t *sem){
+    if (sw->max > 0){
+        unsigned limit = 2u * sw->avg + SPIN_MIN;
+        if (limit > sw->max) limit = sw->max;
+        for (unsigned k = 0; k < limit; ++k){
+            if (sem_trywait(sem) == 0){
+                sw->hits++;
+                sw->spins += k;
+                sw->avg = (7u * sw->avg + k) / 8u;          // media movil: 1/8 de peso al ultimo
+                return 0;
+            }
+            cpu_relax();
+        }
+        sw->spins += limit;
+        sw->avg /= 2u;
+        sw->sleeps++;
+    }
+    return sem_wait(sem);
+}
+
+// Resumen a stderr (solo si se giro)
+static inline void spinwait_report(const spinwait_t *sw, const char *who){
+    if (sw->max == 0) return;
+    unsigned long long n = sw->hits + sw->sleeps;
+    fprintf(stderr, "%s: spin tope=%u esperas=%llu aciertos=%llu (%.1f%%) dormidas=%llu vueltas/espera=%.1f\n",
+            who, sw->max, n, sw->hits, n ? 100.0 * (double)sw->hits / (double)n : 0.0, sw->sleeps,
+            n ? (double)sw->spins / (double)n : 0.0);
+}
+
+#endif // SPINWAIT_H
@@ -0,0 +1,57 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include <stddef.h>
+#include "sharedHeaders.h"
+
+// ABI de estrategias cargables (-S estrategia.so en el jugador).
+// El jugador se queda con la shm, la compuerta G[i] y el pipe, la estrategia solo elige la jugada.
+// Un .so de estrategia exporta estos simbolos con enlace C:
+//
+//   unsigned int strategy_abi_version(void);          // devuelve STRATEGY_ABI_VERSION
+//   int  strategy_init(unsigned short width, unsigned short height, int me, void **ctx);
+//                                                     // 0 si ok, ctx queda a cargo de la estrategia
+//   int  strategy_choose_move(void *ctx, const strategy_view_t *view, unsigned int budget_ms);
+//                                                     // direccion 0..7, <0 si no tiene preferencia
+//   void strategy_shutdown(void *ctx);
+#define STRATEGY_ABI_VERSION 1u
+
+// Vista de solo lectura del estado, armada por el jugador sobre su copia privada.
+// Valida solo durante la llamada a strategy_choose_move (no hace falta lock)
+typedef struct {
+    size_t          size;          // sizeof(strategy_view_t) del jugador, para extender el ABI
+    unsigned short  width;
+    unsigned short  height;
+    unsigned int    num_players;
+    int             me;            // indice propio en players[]
+    const player_t *players;       // num_players entradas
+    const int      *board;         // W*H celdas, mismo esquema que state_t.board
+    unsigned long long hash;       // Zobrist de players + board (zobrist.h), 0 si el master no lo
+                                   // publica; solo si size lo incluye (jugadores viejos no lo mandan)
+} strategy_view_t;
+
+typedef unsigned int (*strategy_abi_fn)(void);
+typedef int  (*strategy_init_fn)(unsigned short width, unsigned short height, int me, void **ctx);
+typedef int  (*strategy_choose_fn)(void *ctx, const strategy_view_t *view, unsigned int budget_ms);
+typedef void (*strategy_shutdown_fn)(void *ctx);
+
+// Estrategia cargada
+typedef struct {
+    void                *handle;   // dlopen
+    void                *ctx;      // contexto propio de la estrategia
+    strategy_init_fn     init;
+    strategy_choose_fn   choose_move;
+    strategy_shutdown_fn shutdown; // opcional
+} strategy_t;
+
+// Carga el .so y resuelve los simbolos. Devuelve 0 si ok, -1 y mensaje en stderr si falla
+int  strategy_load(strategy_t *s, const char *path);
+
+// Llama a shutdown (si hubo init) y cierra el .so
+void strategy_unload(strategy_t *s);
+
+#endif // STRATEGY_H
@@ -0,0 +1,59 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef TILEBOARD_H
+#define TILEBOARD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "sharedHeaders.h"
+
+// Tablero por baldosas de 8 x 8 guardadas una detras de otra (fila de baldosas por fila), y
+// dentro de cada baldosa en orden Z (Morton). Una baldosa son 64 ints = 4 lineas de cache:
+// casi todos los vecinos de una celda caen en la misma baldosa, mientras que en fila por fila
+// los de arriba y abajo estan a W celdas. Sirve para copias privadas que se recorren mucho
+// (escaneo de vecinos, flood fill); /game_state sigue fila por fila (formato de la catedra)
+// y se pasa de uno a otro con tb_load/tb_store. Comparativa en make bench.
+#define TB_SHIFT 3
+#define TB_SIDE  (1 << TB_SHIFT)
+#define TB_CELLS (TB_SIDE * TB_SIDE)
+
+typedef struct {
+    int  width, height;
+    int  tiles_x;               // baldosas por fila (W redondeado hacia arriba / 8)
+    int *cells;                 // tiles_x * tiles_y * 64 (los bordes sobrantes valen 0)
+} tileboard_t;
+
+// 0 si ok, -1 si falla malloc
+int  tb_init(tileboard_t *b, int W, int H);
+void tb_free(tileboard_t *b);
+
+// Desde / hacia un tablero W*H fila por fila
+void tb_load(tileboard_t *b, const int *flat);
+void tb_store(const tileboard_t *b, int *flat);
+
+// intercala los 3 bits bajos de v en las posiciones pares
+static inline int tb_spread3(int v){ return (v & 1) | ((v & 2) << 1) | ((v & 4) << 2); }
+
+static inline int tb_idx(const tileboard_t *b, int x, int y){
+    int tile = (y >> TB_SHIFT) * b->tiles_x + (x >> TB_SHIFT);
+    return (tile << (2 * TB_SHIFT)) | tb_spread3(x & (TB_SIDE - 1)) | (tb_spread3(y & (TB_SIDE - 1)) << 1);
+}
+
+static inline int tb_get(const tileboard_t *b, int x, int y){ return b->cells[tb_idx(b, x, y)]; }
+
+// Mismas reglas que engine_has_valid_move
+bool tb_has_valid_move(const tileboard_t *b, int x, int y);
+
+// Celdas reservadas (multiplo de 64, >= W*H)
+static inline size_t tb_cells(const tileboard_t *b){
+    return (size_t)b->tiles_x * (size_t)((b->height + TB_SIDE - 1) / TB_SIDE) * TB_CELLS;
+}
+
+// Celdas libres alcanzables desde (x,y) moviendose por celdas libres (sin contar (x,y)).
+// stack: W*H ints de trabajo; seen: tb_cells bytes en 0, vuelven con lo visitado marcado
+int  tb_flood_count(const tileboard_t *b, int x, int y, int *stack, uint8_t *seen);
+
+#endif // TILEBOARD_H
@@ -0,0 +1,62 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+// Traza de la partida para chrome://tracing o ui.perfetto.dev (CHOMP_TRACE=archivo.json).
+// Cada proceso (master, vista, jugadores) anota tramos con inicio y duracion en un buffer propio:
+// lo escribe un solo hilo, sin locks ni syscalls salvo el reloj. Al salir vuelca el buffer a
+// archivo.json.<pid> y el master, cuando ya espero a todos, los junta en archivo.json con el
+// formato trace-event de Chrome (un proceso por fila, el reloj es CLOCK_MONOTONIC para todos).
+// Sin la variable trace_begin devuelve 0 y trace_end no hace nada.
+#define TRACE_ENV      "CHOMP_TRACE"
+#define TRACE_MAX_RECS (1u << 22)      // tope por proceso; los tramos de mas se cuentan y se pierden
+
+typedef enum {
+    TR_SELECT = 0,      // master: select esperando jugadas
+    TR_MOVE_READ,       // master: leer y validar una jugada
+    TR_WRITER,          // master: seccion de escritor (espera del lock incluida)
+    TR_REPAINT,         // master: ida y vuelta A/B con la vista
+    TR_VIEW_WAIT,       // vista: esperando A
+    TR_VIEW_COPY,       // vista: copia del estado bajo el lock de lector
+    TR_VIEW_RENDER,     // vista: dibujo con ncurses
+    TR_PLAYER_WAIT,     // jugador: esperando G[i]
+    TR_PLAYER_SYNC,     // jugador: lectura del estado bajo el lock de lector
+    TR_PLAYER_THINK,    // jugador: eleccion de la jugada hasta escribirla
+    TR_NSPANS
+} trace_span_t;
+
+extern bool trace_enabled;
+
+// Lee CHOMP_TRACE y reserva el buffer; who es el nombre del proceso en la traza
+void trace_init(const char *who);
+
+// Anota el tramo s desde t0 hasta ahora; arg es el jugador involucrado (-1 si ninguno)
+void trace_record(trace_span_t s, uint64_t t0, int arg);
+
+// Vuelca el buffer a CHOMP_TRACE.<pid> (trace_init lo registra con atexit; una sola vez)
+void trace_flush(void);
+
+// Master: borra volcados de una corrida anterior con el mismo CHOMP_TRACE
+void trace_discard_stale(void);
+
+// Master: junta todos los CHOMP_TRACE.<pid> en CHOMP_TRACE (JSON) y los borra. 0 si ok
+int  trace_merge(void);
+
+static inline uint64_t trace_begin(void){
+    if (!trace_enabled) return 0;
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static inline void trace_end(trace_span_t s, uint64_t t0, int arg){
+    if (t0) trace_record(s, t0, arg);
+}
+
+#endif // TRACE_H
@@ -0,0 +1,52 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <stdint.h>
+#include "sharedHeaders.h"
+
+// Hash Zobrist del estado (seccion EXT_SEC_ZOBRIST de /game_ext): XOR de una clave por cada
+// celda capturada (celda, dueño) y una por la posicion de cada jugador (celda, jugador).
+// state_t tiene el formato fijo de la catedra, por eso el hash vive en el arena y no al lado
+// del tablero. El master lo actualiza en O(1) en cada captura dentro de su seccion de escritor,
+// asi quien lo lea con el lock de lector ve hash y tablero de la misma jugada: sirve de clave
+// para tablas de transposicion y para comparar estados sin recorrer W x H celdas.
+// Las claves no salen de una tabla sino de mezclar (celda, etiqueta): no ocupan memoria en
+// tableros grandes y cualquier proceso las calcula igual.
+typedef struct {
+    pid_t              master_pid;     // master que lo publica (uno viejo no sirve)
+    unsigned long long hash;           // se escribe con lock de escritor
+} zobrist_t;
+
+// splitmix64 sobre (celda, etiqueta); etiqueta < 32
+static inline uint64_t zobrist_key(uint64_t idx, uint64_t tag){
+    uint64_t z = idx * 32u + tag + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// celda idx capturada por owner / jugador id parado en idx
+static inline uint64_t zobrist_cell(int idx, int owner){ return zobrist_key((uint64_t)idx, 1u + (uint64_t)owner); }
+static inline uint64_t zobrist_pos(int idx, int id){ return zobrist_key((uint64_t)idx, 1u + MAX_PLAYERS + (uint64_t)id); }
+
+// Hash completo, O(W x H): al arrancar una partida o para verificar el publicado
+static inline uint64_t zobrist_full(const state_t *st){
+    uint64_t h = 0;
+    int n = (int)st->width * (int)st->height;
+    for (int i = 0; i < n; ++i)
+        if (st->board[i] <= 0) h ^= zobrist_cell(i, -st->board[i]);
+    for (unsigned p = 0; p < st->num_players && p < MAX_PLAYERS; ++p)
+        h ^= zobrist_pos(idx_xy(st->players[p].pos_x, st->players[p].pos_y, st->width), (int)p);
+    return h;
+}
+
+// El jugador id fue de from a to capturando to
+static inline uint64_t zobrist_move(uint64_t h, int from, int to, int id){
+    return h ^ zobrist_cell(to, id) ^ zobrist_pos(from, id) ^ zobrist_pos(to, id);
+}
+
+#endif // ZOBRIST_H
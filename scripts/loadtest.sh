@@ -0,0 +1,51 @@
+#!/bin/sh
+# This is a personal academic project.
+#
+# Prueba de carga: corre bin/master sin vista barriendo tamaño de tablero, jugadores y delay.
+# Cada corrida agrega una fila a $OUT (ver "master -r"): jugadas/s, latencia p50/p99/p999 de
+# G[i] -> jugada y CPU de master, vista y jugadores.
+#
+# Variables (override: SIZES="50x50 500x500" PLAYERS="2 9" scripts/loadtest.sh):
+#   SIZES    tableros AxH            (default "20x20 100x100 500x500")
+#   PLAYERS  cantidades de jugadores (default "1 2 4 9")
+#   DELAYS   valores de -d en ms     (default "0")
+#   TIMEOUT  -t en segundos          (default 2)
+#   SEED     -s                      (default 1)
+#   GAMES    -g partidas por corrida con los mismos procesos (default 1)
+#   BOT      comando del jugador, recibe "ancho alto" al final (default "./bin/player")
+#   OUT      CSV de salida           (default loadtest.csv)
+set -eu
+
+SIZES=${SIZES:-"20x20 100x100 500x500"}
+PLAYERS=${PLAYERS:-"1 2 4 9"}
+DELAYS=${DELAYS:-"0"}
+TIMEOUT=${TIMEOUT:-2}
+SEED=${SEED:-1}
+GAMES=${GAMES:-1}
+BOT=${BOT:-./bin/player}
+OUT=${OUT:-loadtest.csv}
+MASTER=${MASTER:-./bin/master}
+
+[ -x "$MASTER" ] || { echo "No encuentro $MASTER (make build)"; exit 1; }
+
+# el master ejecuta cada jugador como "<ruta> ancho alto": envolver BOT para poder pasarle opciones
+WRAP=$(mktemp "${TMPDIR:-/tmp}/chomp-bot.XXXXXX")
+trap 'rm -f "$WRAP"' EXIT INT TERM
+printf '#!/bin/sh\nexec %s "$@"\n' "$BOT" > "$WRAP"
+chmod +x "$WRAP"
+
+rm -f "$OUT"
+for size in $SIZES; do
+    w=${size%x*}; h=${size#*x}
+    for n in $PLAYERS; do
+        for d in $DELAYS; do
+            args=""
+            i=0
+            while [ "$i" -lt "$n" ]; do args="$args $WRAP"; i=$((i + 1)); done
+            echo ">> ${w}x${h} jugadores=$n delay=$d"
+            # shellcheck disable=SC2086
+            "$MASTER" -w "$w" -h "$h" -d "$d" -t "$TIMEOUT" -s "$SEED" -g "$GAMES" -r "$OUT" -p $args > /dev/null
+        done
+    done
+done
+echo "✔ resultados en $OUT"
@@ -0,0 +1,68 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#define _GNU_SOURCE             // cpu_set_t, sched_setaffinity
+#include "affinity.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+int placement_parse(placement_t *pl, const char *spec){
+    pl->ncpus = 0;
+    if (strcmp(spec, "auto") == 0){
+        // las CPUs en las que puede correr el master (respeta taskset/cgroups)
+        cpu_set_t set;
+        if (sched_getaffinity(0, sizeof(set), &set) != 0) return -1;
+        for (int c = 0; c < CPU_SETSIZE && pl->ncpus < PLACE_MAX_CPUS; ++c)
+            if (CPU_ISSET((size_t)c, &set)) pl->cpus[pl->ncpus++] = c;
+        return pl->ncpus > 0 ? 0 : -1;
+    }
+    const char *p = spec;
+    while (*p){
+        char *end = NULL;
+        long c = strtol(p, &end, 10);
+        if (end == p || c < 0 || c >= CPU_SETSIZE || pl->ncpus >= PLACE_MAX_CPUS) return -1;
+        pl->cpus[pl->ncpus++] = (int)c;
+        if (*end == ',') end++;
+        else if (*end != '\0') return -1;
+        p = end;
+    }
+    return pl->ncpus > 0 ? 0 : -1;
+}
+
+int placement_set_fifo(placement_t *pl, int prio){
+    int lo = sched_get_priority_min(SCHED_FIFO), hi = sched_get_priority_max(SCHED_FIFO);
+    if (prio < lo || prio > hi) return -1;
+    pl->fifo_prio = prio;
+    return 0;
+}
+
+bool placement_enabled(const placement_t *pl){
+    return pl->ncpus > 0 || pl->fifo_prio > 0;
+}
+
+int placement_apply(const placement_t *pl, pid_t pid, int slot, const char *who){
+    if (!placement_enabled(pl)) return 0;
+    int rc = 0;
+    char cpu[32] = "-", pol[32] = "normal";
+
+    if (pl->ncpus > 0){
+        int c = pl->cpus[slot % pl->ncpus];
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET((size_t)c, &set);
+        if (sched_setaffinity(pid, sizeof(set), &set) == 0) snprintf(cpu, sizeof(cpu), "%d", c);
+        else { snprintf(cpu, sizeof(cpu), "%d(%s)", c, strerror(errno)); rc = -1; }
+    }
+    if (pl->fifo_prio > 0){
+        struct sched_param sp = { .sched_priority = pl->fifo_prio };
+        if (sched_setscheduler(pid, SCHED_FIFO, &sp) == 0) snprintf(pol, sizeof(pol), "fifo:%d", pl->fifo_prio);
+        else { snprintf(pol, sizeof(pol), "normal(fifo: %s)", strerror(errno)); rc = -1; }
+    }
+    fprintf(stderr, "ubicacion: %-8s pid=%-7d cpu=%s politica=%s\n", who, (int)(pid ? pid : getpid()), cpu, pol);
+    return rc;
+}
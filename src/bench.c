@@ -0,0 +1,357 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+// bench: microbenchmarks de los caminos calientes de IPC y del juego.
+// Salida CSV en stdout: bench,param,iters,ns_per_op,ops_per_sec
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE         // MAP_ANONYMOUS
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <sys/select.h>
+#include <sys/wait.h>
+#include <getopt.h>
+#include "ipc.h"
+#include "rwsem.h"
+#include "engine.h"
+#include "tileboard.h"
+
+static int quick = 0;   // -q: menos iteraciones (para CI o pruebas rapidas)
+
+static uint64_t now_ns(void){
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static unsigned long iters(unsigned long n){ return quick ? (n / 20 + 1) : n; }
+
+static void report(const char *bench, const char *param, unsigned long n, uint64_t ns){
+    double per = (n > 0) ? (double)ns / (double)n : 0.0;
+    printf("%s,%s,%lu,%.1f,%.0f\n", bench, param, n, per, per > 0 ? 1e9 / per : 0.0);
+    fflush(stdout);
+}
+
+// sync_t en memoria compartida anonima: sirve entre hilos y entre procesos hijos
+static sync_t *sync_anon(void){
+    void *p = mmap(NULL, sizeof(sync_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) { perror("mmap"); exit(1); }
+    memset(p, 0, sizeof(sync_t));
+    if (ipc_init_sync_semaphores(p) != 0) { perror("sem_init"); exit(1); }
+    return p;
+}
+
+// ---- rwsem bajo contencion ----
+
+typedef struct { sync_t *sy; atomic_bool *stop; unsigned long ops; } rw_arg_t;
+
+static void *rw_reader_loop(void *arg){
+    rw_arg_t *a = arg;
+    while (!atomic_load_explicit(a->stop, memory_order_relaxed)) {
+        rw_reader_enter(a->sy);
+        rw_reader_exit(a->sy);
+        a->ops++;
+    }
+    return NULL;
+}
+
+static void *rw_writer_loop(void *arg){
+    rw_arg_t *a = arg;
+    while (!atomic_load_explicit(a->stop, memory_order_relaxed)) {
+        rw_writer_enter(a->sy);
+        rw_writer_exit(a->sy);
+        a->ops++;
+    }
+    return NULL;
+}
+
+// nreaders lectores contra 1 escritor durante un intervalo fijo
+static void bench_rwsem(int nreaders){
+    sync_t *sy = sync_anon();
+    atomic_bool stop; atomic_init(&stop, false);
+    rw_arg_t ra[16], wa = { sy, &stop, 0 };
+    pthread_t rt[16], wt;
+    int started = 0, rc = 0;
+    for (; started < nreaders; ++started) {
+        ra[started] = (rw_arg_t){ sy, &stop, 0 };
+        if ((rc = pthread_create(&rt[started], NULL, rw_reader_loop, &ra[started])) != 0) break;
+    }
+    if (rc == 0) rc = pthread_create(&wt, NULL, rw_writer_loop, &wa);
+    if (rc != 0) {
+        // se cancela la medicion: se paran y esperan solo los hilos que arrancaron
+        fprintf(stderr, "bench: rwsem readers=%d: pthread_create: %s\n", nreaders, strerror(rc));
+        atomic_store(&stop, true);
+        for (int i = 0; i < started; ++i) pthread_join(rt[i], NULL);
+        munmap(sy, sizeof(*sy));
+        return;
+    }
+
+    uint64_t t0 = now_ns();
+    struct timespec d = { 0, quick ? 50000000L : 500000000L };
+    nanosleep(&d, NULL);
+    atomic_store(&stop, true);
+    for (int i = 0; i < nreaders; ++i) pthread_join(rt[i], NULL);
+    pthread_join(wt, NULL);
+    uint64_t ns = now_ns() - t0;
+
+    unsigned long rops = 0;
+    for (int i = 0; i < nreaders; ++i) rops += ra[i].ops;
+    char param[32];
+    snprintf(param, sizeof(param), "readers=%d", nreaders);
+    // ns por operacion de cada hilo (tiempo de pared / ops de ese rol, promedio por hilo)
+    report("rwsem_reader_enter_exit", param, rops, rops ? ns * (uint64_t)nreaders : 0);
+    report("rwsem_writer_enter_exit", param, wa.ops, ns);
+    munmap(sy, sizeof(*sy));
+}
+
+// ---- repaint A/B con una vista en otro proceso ----
+
+static void bench_repaint(void){
+    sync_t *sy = sync_anon();
+    unsigned long n = iters(200000);
+    pid_t c = fork();
+    if (c == 0) {
+        for (unsigned long i = 0; i < n; ++i) { sem_wait(&sy->A); sem_post(&sy->B); }
+        _exit(0);
+    }
+    uint64_t t0 = now_ns();
+    for (unsigned long i = 0; i < n; ++i) { sem_post(&sy->A); sem_wait(&sy->B); }
+    uint64_t ns = now_ns() - t0;
+    waitpid(c, NULL, 0);
+    report("repaint_round_trip", "process", n, ns);
+    munmap(sy, sizeof(*sy));
+}
+
+// ---- latencia de una jugada: post G[i] -> byte leido por el master con select ----
+
+static void bench_pipe_move(void){
+    sync_t *sy = sync_anon();
+    int pfd[2];
+    if (pipe(pfd) != 0) { perror("pipe"); exit(1); }
+    unsigned long n = iters(200000);
+    pid_t c = fork();
+    if (c == 0) {
+        close(pfd[0]);
+        unsigned char dir = 0;
+        for (unsigned long i = 0; i < n; ++i) {
+            sem_wait(&sy->G[0]);
+            if (write(pfd[1], &dir, 1) != 1) _exit(1);
+        }
+        _exit(0);
+    }
+    close(pfd[1]);
+    uint64_t t0 = now_ns();
+    for (unsigned long i = 0; i < n; ++i) {
+        sem_post(&sy->G[0]);
+        fd_set rfds; FD_ZERO(&rfds); FD_SET(pfd[0], &rfds);
+        if (select(pfd[0] + 1, &rfds, NULL, NULL, NULL) < 0 && errno != EINTR) { perror("select"); break; }
+        unsigned char dir;
+        if (read(pfd[0], &dir, 1) != 1) break;
+    }
+    uint64_t ns = now_ns() - t0;
+    close(pfd[0]);
+    waitpid(c, NULL, 0);
+    report("pipe_move_round_trip", "select", n, ns);
+    munmap(sy, sizeof(*sy));
+}
+
+// ---- reglas ----
+
+// threads = 0: reparto automatico del motor
+static void bench_fill(int W, int H, int threads){
+    int *board = malloc((size_t)W * (size_t)H * sizeof(int));
+    if (!board) { perror("malloc"); return; }
+    unsigned long reps = iters((unsigned long)(50000000ull / ((uint64_t)W * (uint64_t)H)) + 1);
+    uint64_t t0 = now_ns();
+    for (unsigned long r = 0; r < reps; ++r) engine_fill_board(board, W, H, (unsigned)r, threads);
+    uint64_t ns = now_ns() - t0;
+    char param[32];
+    snprintf(param, sizeof(param), "%dx%d threads=%d", W, H, threads);
+    report("board_fill_random_cell", param, reps * (unsigned long)W * (unsigned long)H, ns);
+    free(board);
+}
+
+static void bench_has_valid_move(int W, int H){
+    int *board = malloc((size_t)W * (size_t)H * sizeof(int));
+    if (!board) { perror("malloc"); return; }
+    engine_fill_board(board, W, H, 1, 0);
+    // la mitad de las celdas capturadas, asi el escaneo no corta siempre en el primer vecino
+    unsigned s = 7;
+    for (int i = 0; i < W * H; ++i) if (rand_r(&s) & 1) board[i] = -(rand_r(&s) % MAX_PLAYERS);
+
+    unsigned long n = iters(20000000);
+    unsigned long hits = 0;
+    uint32_t x = 12345;
+    uint64_t t0 = now_ns();
+    for (unsigned long i = 0; i < n; ++i) {
+        x = x * 1664525u + 1013904223u;
+        int px = (int)((x >> 8) % (unsigned)W), py = (int)((x >> 4) % (unsigned)H);
+        hits += engine_has_valid_move(board, W, H, px, py);
+    }
+    uint64_t ns = now_ns() - t0;
+    char param[48];
+    snprintf(param, sizeof(param), "%dx%d hits=%lu", W, H, hits);
+    report("has_valid_move", param, n, ns);
+
+    // mismo tablero y mismas posiciones sobre la copia con borde
+    padboard_t pb;
+    if (padboard_init(&pb, W, H) != 0) { perror("malloc"); free(board); return; }
+    padboard_load(&pb, board);
+    hits = 0; x = 12345;
+    t0 = now_ns();
+    for (unsigned long i = 0; i < n; ++i) {
+        x = x * 1664525u + 1013904223u;
+        int px = (int)((x >> 8) % (unsigned)W), py = (int)((x >> 4) % (unsigned)H);
+        hits += padboard_has_valid_move(&pb, padboard_idx(&pb, px, py));
+    }
+    ns = now_ns() - t0;
+    snprintf(param, sizeof(param), "%dx%d hits=%lu", W, H, hits);
+    report("has_valid_move_padded", param, n, ns);
+    padboard_free(&pb);
+    free(board);
+}
+
+// ---- fila por fila vs baldosas en orden Z (tileboard.h) ----
+
+// vecinos libres de cada celda recorriendo el tablero por coordenadas
+static unsigned long scan_rowmajor(const int *board, int W, int H){
+    unsigned long free_nb = 0;
+    for (int y = 0; y < H; ++y)
+        for (int x = 0; x < W; ++x)
+            for (int d = 0; d < 8; ++d){
+                int nx = x + DX[d], ny = y + DY[d];
+                if (in_bounds(nx, ny, W, H) && board[idx_xy(nx, ny, W)] > 0) free_nb++;
+            }
+    return free_nb;
+}
+
+static unsigned long scan_tiled(const tileboard_t *b){
+    unsigned long free_nb = 0;
+    for (int y = 0; y < b->height; ++y)
+        for (int x = 0; x < b->width; ++x)
+            for (int d = 0; d < 8; ++d){
+                int nx = x + DX[d], ny = y + DY[d];
+                if (in_bounds(nx, ny, b->width, b->height) && tb_get(b, nx, ny) > 0) free_nb++;
+            }
+    return free_nb;
+}
+
+static void bench_layout(int W, int H){
+    size_t cells = (size_t)W * (size_t)H;
+    int *board = malloc(cells * sizeof(int));
+    int *stack = malloc(cells * sizeof(int));
+    tileboard_t tb;
+    if (!board || !stack || tb_init(&tb, W, H) != 0) { perror("malloc"); free(board); free(stack); return; }
+    uint8_t *seen = malloc(tb_cells(&tb));
+    if (!seen) { perror("malloc"); tb_free(&tb); free(board); free(stack); return; }
+    engine_fill_board(board, W, H, 1, 0);
+    // 40% capturadas: con 8 vecinos las libres siguen formando una zona grande que recorrer
+    unsigned s = 11;
+    for (size_t i = 0; i < cells; ++i) if (rand_r(&s) % 10 < 4) board[i] = -(int)(rand_r(&s) % MAX_PLAYERS);
+    tb_load(&tb, board);
+    char param[48];
+
+    unsigned long reps = iters((unsigned long)(20000000ull / cells) + 1), sum_r = 0, sum_t = 0;
+    uint64_t t0 = now_ns();
+    for (unsigned long r = 0; r < reps; ++r) sum_r += scan_rowmajor(board, W, H);
+    uint64_t ns_r = now_ns() - t0;
+    t0 = now_ns();
+    for (unsigned long r = 0; r < reps; ++r) sum_t += scan_tiled(&tb);
+    uint64_t ns_t = now_ns() - t0;
+    snprintf(param, sizeof(param), "%dx%d row-major", W, H);
+    report("neighbor_scan_cell", param, reps * cells, ns_r);
+    snprintf(param, sizeof(param), "%dx%d tiled-z%s", W, H, sum_r == sum_t ? "" : " DISTINTO");
+    report("neighbor_scan_cell", param, reps * cells, ns_t);
+
+    // flood fill desde el centro (o la primera libre despues): ns por celda visitada
+    int sx = W / 2, sy = H / 2;
+    while (board[idx_xy(sx, sy, W)] <= 0) { if (++sx == W) { sx = 0; sy = (sy + 1) % H; } }
+    reps = iters((unsigned long)(4000000ull / cells) + 1);
+    unsigned long visited_r = 0, visited_t = 0;
+    ns_r = ns_t = 0;
+    for (unsigned long r = 0; r < reps; ++r){
+        memset(seen, 0, cells);
+        t0 = now_ns();
+        visited_r += (unsigned long)engine_flood_count(board, W, H, sx, sy, stack, seen) + 1u;
+        ns_r += now_ns() - t0;
+        memset(seen, 0, tb_cells(&tb));
+        t0 = now_ns();
+        visited_t += (unsigned long)tb_flood_count(&tb, sx, sy, stack, seen) + 1u;
+        ns_t += now_ns() - t0;
+    }
+    snprintf(param, sizeof(param), "%dx%d row-major", W, H);
+    report("flood_fill_cell", param, visited_r, ns_r);
+    snprintf(param, sizeof(param), "%dx%d tiled-z%s", W, H, visited_r == visited_t ? "" : " DISTINTO");
+    report("flood_fill_cell", param, visited_t, ns_t);
+
+    free(seen); tb_free(&tb); free(stack); free(board);
+}
+
+// ---- /game_state: crear + mapear + inicializar segun tamaño ----
+// ipc_create_and_map_state no escribe el tablero (ftruncate ya lo deja en cero): se toca una vez
+// cada pagina del mapeo para que entren los page faults, que es lo que crece con el tamaño
+
+static void bench_create_state(unsigned short W, unsigned short H){
+    char param[32];
+    snprintf(param, sizeof(param), "%ux%u", (unsigned)W, (unsigned)H);
+    // si /game_state ya existe (partida en curso o restos de una) no la pisamos
+    int fd = shm_open(ipc_shm_name(SHM_STATE), O_RDONLY, 0);
+    if (fd >= 0) {
+        close(fd);
+        printf("# ipc_create_and_map_state,%s: /game_state ya existe (shm_tool destroy), se omite\n", param);
+        return;
+    }
+    unsigned long n = iters(W >= 2000 ? 20 : 200);
+    size_t size = ipc_state_size(W, H), page = (size_t)sysconf(_SC_PAGESIZE);
+    uint64_t ns = 0;
+    for (unsigned long i = 0; i < n; ++i) {
+        bool existed = false;
+        uint64_t t0 = now_ns();
+        state_t *st = ipc_create_and_map_state(W, H, &existed);
+        if (!st) { perror("create state"); return; }
+        volatile unsigned char *p = (volatile unsigned char *)st;
+        for (size_t off = 0; off < size; off += page) p[off] = 0;
+        ns += now_ns() - t0;
+        ipc_unmap_state(st);
+        ipc_unlink_state();
+    }
+    report("ipc_create_and_map_state", param, n, ns);
+}
+
+int main(int argc, char **argv){
+    int opt;
+    while ((opt = getopt(argc, argv, "q")) != -1) {
+        if (opt == 'q') quick = 1;
+        else { fprintf(stderr, "Uso: %s [-q]\n", argv[0]); return 1; }
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    printf("bench,param,iters,ns_per_op,ops_per_sec\n");
+    bench_rwsem(1);
+    bench_rwsem(4);
+    bench_repaint();
+    bench_pipe_move();
+    bench_fill(100, 100, 1);
+    bench_fill(2000, 2000, 1);
+    bench_fill(2000, 2000, 0);
+    bench_has_valid_move(100, 100);
+    bench_has_valid_move(2000, 2000);
+    bench_layout(100, 100);
+    bench_layout(4000, 1000);
+
+    // si ya existe /game_state se omite (ver bench_create_state)
+    bench_create_state(100, 100);
+    bench_create_state(1000, 1000);
+    bench_create_state(4000, 4000);
+    return 0;
+}
@@ -0,0 +1,120 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "chunkboard.h"
+#include "engine.h"
+#include <stdlib.h>
+
+static size_t bucket_of(const chunkboard_t *cb, uint32_t cx, uint32_t cy){
+    uint64_t k = ((uint64_t)cy << 32 | cx) * 0x9E3779B97F4A7C15ull;
+    return (size_t)(k >> 32) & (cb->nbuckets - 1);
+}
+
+int cb_init(chunkboard_t *cb, uint32_t w, uint32_t h, unsigned seed){
+    cb->width = w; cb->height = h; cb->seed = seed;
+    cb->nbuckets = 64;
+    cb->nchunks = 0;
+    cb->free_list = NULL;
+    cb->last = NULL;
+    cb->buckets = calloc(cb->nbuckets, sizeof(chunk_t*));
+    return cb->buckets ? 0 : -1;
+}
+
+void cb_reset(chunkboard_t *cb, unsigned seed){
+    for (size_t b = 0; b < cb->nbuckets; ++b){
+        chunk_t *c = cb->buckets[b];
+        while (c){
+            chunk_t *n = c->next;
+            c->next = cb->free_list;
+            cb->free_list = c;
+            c = n;
+        }
+        cb->buckets[b] = NULL;
+    }
+    cb->nchunks = 0;
+    cb->last = NULL;
+    cb->seed = seed;
+}
+
+static chunk_t *find(chunkboard_t *cb, uint32_t cx, uint32_t cy){
+    if (cb->last && cb->last->cx == cx && cb->last->cy == cy) return cb->last;
+    for (chunk_t *c = cb->buckets[bucket_of(cb, cx, cy)]; c; c = c->next){
+        if (c->cx == cx && c->cy == cy){ cb->last = c; return c; }
+    }
+    return NULL;
+}
+
+// duplica la tabla cuando hay mas bloques que buckets
+static void grow(chunkboard_t *cb){
+    size_t n = cb->nbuckets * 2;
+    chunk_t **nb = calloc(n, sizeof(chunk_t*));
+    if (!nb) return;                            // sigue andando, con cadenas mas largas
+    chunk_t **old = cb->buckets;
+    size_t old_n = cb->nbuckets;
+    cb->buckets = nb; cb->nbuckets = n;
+    for (size_t b = 0; b < old_n; ++b){
+        chunk_t *c = old[b];
+        while (c){
+            chunk_t *next = c->next;
+            size_t k = bucket_of(cb, c->cx, c->cy);
+            c->next = nb[k]; nb[k] = c;
+            c = next;
+        }
+    }
+    free(old);
+}
+
+static chunk_t *materialize(chunkboard_t *cb, uint32_t cx, uint32_t cy){
+    chunk_t *c = cb->free_list;
+    if (c) cb->free_list = c->next;
+    else if (!(c = malloc(sizeof(*c)))) return NULL;
+    c->cx = cx; c->cy = cy;
+
+    // mismas recompensas que tendria la celda sin materializar (fuera del tablero quedan en 0)
+    for (uint32_t j = 0; j < CHUNK_SIDE; ++j){
+        uint64_t y = ((uint64_t)cy << CHUNK_SHIFT) + j;
+        for (uint32_t i = 0; i < CHUNK_SIDE; ++i){
+            uint64_t x = ((uint64_t)cx << CHUNK_SHIFT) + i;
+            c->cells[j * CHUNK_SIDE + i] = (x < cb->width && y < cb->height)
+                ? engine_cell_reward(cb->seed, y * cb->width + x) : 0;
+        }
+    }
+    if (cb->nchunks >= cb->nbuckets) grow(cb);
+    size_t k = bucket_of(cb, cx, cy);
+    c->next = cb->buckets[k];
+    cb->buckets[k] = c;
+    cb->nchunks++;
+    cb->last = c;
+    return c;
+}
+
+int cb_get(chunkboard_t *cb, uint32_t x, uint32_t y){
+    chunk_t *c = find(cb, x >> CHUNK_SHIFT, y >> CHUNK_SHIFT);
+    if (c) return c->cells[(y & (CHUNK_SIDE - 1)) * CHUNK_SIDE + (x & (CHUNK_SIDE - 1))];
+    return engine_cell_reward(cb->seed, (uint64_t)y * cb->width + x);
+}
+
+int cb_set(chunkboard_t *cb, uint32_t x, uint32_t y, int v){
+    uint32_t cx = x >> CHUNK_SHIFT, cy = y >> CHUNK_SHIFT;
+    chunk_t *c = find(cb, cx, cy);
+    if (!c && !(c = materialize(cb, cx, cy))) return -1;
+    c->cells[(y & (CHUNK_SIDE - 1)) * CHUNK_SIDE + (x & (CHUNK_SIDE - 1))] = v;
+    return 0;
+}
+
+size_t cb_bytes(const chunkboard_t *cb){
+    return cb->nchunks * sizeof(chunk_t) + cb->nbuckets * sizeof(chunk_t*);
+}
+
+void cb_free(chunkboard_t *cb){
+    cb_reset(cb, cb->seed);
+    while (cb->free_list){
+        chunk_t *n = cb->free_list->next;
+        free(cb->free_list);
+        cb->free_list = n;
+    }
+    free(cb->buckets);
+    cb->buckets = NULL;
+    cb->nbuckets = 0;
+}
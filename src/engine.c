@@ -0,0 +1,316 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#define _POSIX_C_SOURCE 200809L
+#include "engine.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+move_result_t engine_check_move(const int *board, int W, int H, int x, int y, unsigned dir, int *idx){
+    if (dir > 7) return MOVE_BAD_DIR;
+    int nx = x + DX[dir];
+    int ny = y + DY[dir];
+    if (!in_bounds(nx, ny, W, H)) return MOVE_OUT_OF_BOUNDS;
+    int i = idx_xy(nx, ny, W);
+    if (board[i] <= 0) return MOVE_NOT_FREE;
+    *idx = i;
+    return MOVE_VALID;
+}
+
+void engine_commit_move(int *board, int W, player_t *p, int id, int idx){
+    p->v_moves++;
+    p->score += (unsigned int)board[idx];  // suma recompensa
+    board[idx] = -id;                      // capturada por id
+    p->pos_x = (unsigned short)(idx % W);
+    p->pos_y = (unsigned short)(idx / W);
+}
+
+bool engine_has_valid_move(const int *board, int W, int H, int x, int y){
+    for (int d = 0; d < 8; ++d){
+        int nx = x + DX[d], ny = y + DY[d];
+        if (!in_bounds(nx, ny, W, H)) continue;
+        if (board[idx_xy(nx, ny, W)] > 0) return true;
+    }
+    return false;
+}
+
+int engine_flood_count(const int *board, int W, int H, int x, int y, int *stack, uint8_t *seen){
+    int top = 0, count = 0;
+    stack[top++] = idx_xy(x, y, W);
+    seen[idx_xy(x, y, W)] = 1;
+    while (top > 0){
+        int c = stack[--top];
+        int cx = c % W, cy = c / W;
+        for (int d = 0; d < 8; ++d){
+            int nx = cx + DX[d], ny = cy + DY[d];
+            if (!in_bounds(nx, ny, W, H)) continue;
+            int t = idx_xy(nx, ny, W);
+            if (seen[t] || board[t] <= 0) continue;
+            seen[t] = 1;
+            stack[top++] = t;
+            count++;
+        }
+    }
+    return count;
+}
+
+// bloque de filas [y0, y1) para un hilo de llenado
+typedef struct { int *board; int W, y0, y1; unsigned int seed; } fill_job_t;
+
+static void *fill_rows(void *arg){
+    const fill_job_t *j = arg;
+    uint64_t end = (uint64_t)j->y1 * (uint64_t)j->W;
+    for (uint64_t i = (uint64_t)j->y0 * (uint64_t)j->W; i < end; ++i)
+        j->board[i] = engine_cell_reward(j->seed, i);
+    return NULL;
+}
+
+#define FILL_MIN_CELLS  (1 << 18)       // por debajo no conviene crear hilos
+#define FILL_MAX_THREADS 64
+
+void engine_fill_board(int *board, int W, int H, unsigned int seed, int threads){
+    uint64_t cells = (uint64_t)W * (uint64_t)H;
+    if (threads <= 0){
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        uint64_t by_size = cells / FILL_MIN_CELLS;
+        threads = (int)((cpus < 1) ? 1 : cpus);
+        if ((uint64_t)threads > by_size) threads = (int)by_size;
+    }
+    if (threads > FILL_MAX_THREADS) threads = FILL_MAX_THREADS;
+    if (threads > H) threads = H;
+    if (threads < 1) threads = 1;
+
+    fill_job_t jobs[FILL_MAX_THREADS];
+    pthread_t th[FILL_MAX_THREADS];
+    bool started[FILL_MAX_THREADS] = {0};
+    for (int t = 0; t < threads; ++t)
+        jobs[t] = (fill_job_t){ board, W, (int)((int64_t)H * t / threads), (int)((int64_t)H * (t + 1) / threads), seed };
+    for (int t = 1; t < threads; ++t)
+        started[t] = (pthread_create(&th[t], NULL, fill_rows, &jobs[t]) == 0);
+    // el bloque 0 lo hace el hilo que llama, y tambien el de cualquier hilo que no arranco
+    for (int t = 0; t < threads; ++t)
+        if (!started[t]) fill_rows(&jobs[t]);
+    for (int t = 1; t < threads; ++t)
+        if (started[t]) pthread_join(th[t], NULL);
+}
+
+void engine_distribute_positions(int n, int W, int H, int *px, int *py){
+    int R = 1; while (R*R < n) R++;             // filas
+    int C = (n + R - 1) / R;                    // columnas
+    int stepX = (C > 0) ? (W / (C + 1)) : W;
+    int stepY = (R > 0) ? (H / (R + 1)) : H;
+    int k = 0;
+    for (int r=0; r<R && k<n; ++r)
+        for (int c=0; c<C && k<n; ++c){
+            int x = (c + 1) * stepX; if (x<0) x=0; if (x>=W) x=W-1;
+            int y = (r + 1) * stepY; if (y<0) y=0; if (y>=H) y=H-1;
+            px[k]=x; py[k]=y; ++k;
+        }
+}
+
+void engine_place_players(int *board, int W, player_t *players, int n, const int *px, const int *py){
+    for (int i = 0; i < n; ++i){
+        board[idx_xy(px[i], py[i], W)] = -i;   // capturada por i (nota: id=0 => celda=0)
+        players[i].pos_x = (unsigned short)px[i];
+        players[i].pos_y = (unsigned short)py[i];
+    }
+}
+
+int engine_winner(const player_t *players, int n){
+    int winner = -1;
+    for (int i = 0; i < n; ++i){
+        if (winner < 0){ winner = i; continue; }
+        // Criterios de desempate, mas validos, menos invalidos, menor pid
+        const player_t *p = &players[i], *w = &players[winner];
+        if (p->score > w->score ||
+           (p->score == w->score && p->v_moves > w->v_moves) ||
+           (p->score == w->score && p->v_moves == w->v_moves && p->inv_moves < w->inv_moves) ||
+           (p->score == w->score && p->v_moves == w->v_moves && p->inv_moves == w->inv_moves && p->player_pid < w->player_pid)){
+            winner = i;
+        }
+    }
+    return winner;
+}
+
+// ---- partidas en memoria ----
+
+int engine_game_init(engine_game_t *g, int W, int H, int nplayers){
+    memset(g, 0, sizeof(*g));
+    if (nplayers < 1 || nplayers > MAX_PLAYERS) return -1;
+    g->width = W; g->height = H; g->num_players = nplayers;
+    g->board = malloc((size_t)W * (size_t)H * sizeof(int));
+    if (!g->board) return -1;
+    if (padboard_init(&g->pad, W, H) != 0) { free(g->board); g->board = NULL; return -1; }
+    return 0;
+}
+
+void engine_game_reset(engine_game_t *g, unsigned int seed){
+    int px[MAX_PLAYERS], py[MAX_PLAYERS];
+    memset(g->players, 0, sizeof(g->players));
+    for (int i = 0; i < g->num_players; ++i)
+        g->players[i].name[0] = (char)('0' + i);
+    g->rounds = 0; g->moves = 0;
+    engine_fill_board(g->board, g->width, g->height, seed, 1);   // las partidas ya corren en paralelo
+    engine_distribute_positions(g->num_players, g->width, g->height, px, py);
+    engine_place_players(g->board, g->width, g->players, g->num_players, px, py);
+    padboard_load(&g->pad, g->board);
+}
+
+void engine_game_play(engine_game_t *g, engine_strategy_fn strat[], void *ctx[], unsigned max_idle_rounds){
+    padboard_t *pb = &g->pad;
+    unsigned idle = 0;
+
+    // quien arranca sin salida queda bloqueado de entrada
+    int active = 0;
+    for (int i = 0; i < g->num_players; ++i){
+        player_t *p = &g->players[i];
+        p->blocked = !padboard_has_valid_move(pb, padboard_idx(pb, p->pos_x, p->pos_y));
+        if (!p->blocked) active++;
+    }
+
+    while (active > 0 && idle < max_idle_rounds){
+        bool any_valid = false;
+        for (int i = 0; i < g->num_players; ++i){
+            player_t *p = &g->players[i];
+            if (p->blocked) continue;
+            int at = padboard_idx(pb, p->pos_x, p->pos_y);
+            if (!padboard_has_valid_move(pb, at)){
+                p->blocked = true;      // lo encerraron los demas
+                active--;
+                continue;
+            }
+            int dir = strat[i](g, i, ctx[i]);
+            int to = (dir >= 0) ? padboard_target(pb, at, (unsigned)dir) : -1;
+            if (to >= 0){
+                engine_commit_move(g->board, g->width, p, i, padboard_flat(pb, to));
+                pb->cells[to] = -i;     // la copia con borde sigue al tablero plano
+                at = to;
+                any_valid = true;
+            } else {
+                engine_reject_move(p);
+            }
+            g->moves++;
+            if (!padboard_has_valid_move(pb, at)){
+                p->blocked = true;
+                active--;
+            }
+        }
+        g->rounds++;
+        idle = any_valid ? 0 : idle + 1;
+    }
+}
+
+void engine_game_free(engine_game_t *g){
+    free(g->board);
+    g->board = NULL;
+    padboard_free(&g->pad);
+}
+
+// ---- partidas sobre tablero por bloques ----
+
+int engine_cgame_init(engine_cgame_t *g, uint32_t W, uint32_t H, int nplayers){
+    memset(g, 0, sizeof(*g));
+    if (nplayers < 1 || nplayers > MAX_PLAYERS || W == 0 || H == 0) return -1;
+    g->num_players = nplayers;
+    return cb_init(&g->board, W, H, 0);
+}
+
+int engine_cgame_reset(engine_cgame_t *g, unsigned int seed){
+    chunkboard_t *b = &g->board;
+    cb_reset(b, seed);
+    memset(g->players, 0, sizeof(g->players));
+    g->rounds = 0; g->moves = 0;
+
+    // mismo reparto que engine_distribute_positions, en 64 bits
+    int n = g->num_players;
+    int R = 1; while (R*R < n) R++;
+    int C = (n + R - 1) / R;
+    uint64_t stepX = b->width / (uint64_t)(C + 1), stepY = b->height / (uint64_t)(R + 1);
+    int k = 0;
+    for (int r = 0; r < R && k < n; ++r)
+        for (int c = 0; c < C && k < n; ++c, ++k){
+            uint64_t x = (uint64_t)(c + 1) * stepX, y = (uint64_t)(r + 1) * stepY;
+            if (x >= b->width) x = b->width - 1;
+            if (y >= b->height) y = b->height - 1;
+            g->players[k].x = (uint32_t)x;
+            g->players[k].y = (uint32_t)y;
+            if (cb_set(b, (uint32_t)x, (uint32_t)y, -k) != 0) return -1;
+        }
+    return 0;
+}
+
+// vecino d de (x,y) si esta dentro del tablero
+static bool cneighbor(const chunkboard_t *b, uint32_t x, uint32_t y, int d, uint32_t *nx, uint32_t *ny){
+    int64_t ax = (int64_t)x + DX[d], ay = (int64_t)y + DY[d];
+    if (ax < 0 || ay < 0 || ax >= (int64_t)b->width || ay >= (int64_t)b->height) return false;
+    *nx = (uint32_t)ax; *ny = (uint32_t)ay;
+    return true;
+}
+
+bool engine_cgame_has_valid_move(engine_cgame_t *g, uint32_t x, uint32_t y){
+    for (int d = 0; d < 8; ++d){
+        uint32_t nx, ny;
+        if (cneighbor(&g->board, x, y, d, &nx, &ny) && cb_get(&g->board, nx, ny) > 0) return true;
+    }
+    return false;
+}
+
+void engine_cgame_play(engine_cgame_t *g, engine_cstrategy_fn strat[], void *ctx[], unsigned max_idle_rounds){
+    unsigned idle = 0;
+    int active = 0;
+    for (int i = 0; i < g->num_players; ++i){
+        engine_cplayer_t *p = &g->players[i];
+        p->blocked = !engine_cgame_has_valid_move(g, p->x, p->y);
+        if (!p->blocked) active++;
+    }
+
+    while (active > 0 && idle < max_idle_rounds){
+        bool any_valid = false;
+        for (int i = 0; i < g->num_players; ++i){
+            engine_cplayer_t *p = &g->players[i];
+            if (p->blocked) continue;
+            if (!engine_cgame_has_valid_move(g, p->x, p->y)){
+                p->blocked = true;
+                active--;
+                continue;
+            }
+            int dir = strat[i](g, i, ctx[i]);
+            uint32_t nx, ny;
+            int v = 0;
+            if (dir >= 0 && dir <= 7 && cneighbor(&g->board, p->x, p->y, dir, &nx, &ny) &&
+                (v = cb_get(&g->board, nx, ny)) > 0 && cb_set(&g->board, nx, ny, -i) == 0){
+                p->v_moves++;
+                p->score += (unsigned)v;
+                p->x = nx; p->y = ny;
+                any_valid = true;
+            } else {
+                p->inv_moves++;
+            }
+            g->moves++;
+            if (!engine_cgame_has_valid_move(g, p->x, p->y)){
+                p->blocked = true;
+                active--;
+            }
+        }
+        g->rounds++;
+        idle = any_valid ? 0 : idle + 1;
+    }
+}
+
+int engine_cgame_winner(const engine_cgame_t *g){
+    player_t ps[MAX_PLAYERS];
+    memset(ps, 0, sizeof(ps));
+    for (int i = 0; i < g->num_players; ++i){
+        ps[i].score = g->players[i].score;
+        ps[i].v_moves = g->players[i].v_moves;
+        ps[i].inv_moves = g->players[i].inv_moves;
+    }
+    return engine_winner(ps, g->num_players);
+}
+
+void engine_cgame_free(engine_cgame_t *g){
+    cb_free(&g->board);
+}
@@ -0,0 +1,69 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#define _GNU_SOURCE             // syscall(SYS_futex)
+#include "frame.h"
+#include <limits.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "rwsem.h"
+
+#define SNAPSHOT_TRIES 8        // copias descartadas antes de pedir el lock de lector
+
+// futex compartido entre procesos (sin FUTEX_PRIVATE_FLAG)
+static void futex_wait(_Atomic uint32_t *addr, uint32_t val, int timeout_ms){
+    struct timespec ts = { timeout_ms / 1000, (long)(timeout_ms % 1000) * 1000000L };
+    syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAIT, val, timeout_ms >= 0 ? &ts : NULL, NULL, 0);
+}
+
+static void futex_wake_all(_Atomic uint32_t *addr){
+    syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+void frame_reset(frame_t *fr, pid_t master){
+    uint32_t e = atomic_load(&fr->epoch);
+    if (e & 1u) atomic_store(&fr->epoch, e + 1u);
+    fr->master_pid = master;
+}
+
+void frame_write_begin(frame_t *fr){
+    atomic_fetch_add_explicit(&fr->epoch, 1u, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);    // el epoch impar se ve antes que los datos
+}
+
+void frame_write_end(frame_t *fr){
+    atomic_fetch_add_explicit(&fr->epoch, 1u, memory_order_seq_cst);
+    // seq_cst contra el waiters++ del espectador: o ve el epoch nuevo o lo despertamos
+    if (atomic_load(&fr->waiters) > 0) futex_wake_all(&fr->epoch);
+}
+
+uint32_t frame_wait(frame_t *fr, uint32_t last, int timeout_ms){
+    uint32_t e = atomic_load(&fr->epoch);
+    if (e != last && (e & 1u) == 0) return e;
+    atomic_fetch_add(&fr->waiters, 1u);
+    e = atomic_load(&fr->epoch);
+    if (e == last || (e & 1u)) futex_wait(&fr->epoch, e, timeout_ms);
+    atomic_fetch_sub(&fr->waiters, 1u);
+    return atomic_load(&fr->epoch);
+}
+
+uint32_t frame_snapshot(const frame_t *fr, const state_t *st, state_t *dst, size_t size, sync_t *sy){
+    for (int i = 0; i < SNAPSHOT_TRIES; ++i){
+        uint32_t e1 = atomic_load_explicit(&fr->epoch, memory_order_acquire);
+        if (e1 & 1u) { sched_yield(); continue; }
+        memcpy(dst, st, size);
+        atomic_thread_fence(memory_order_acquire);
+        uint32_t e2 = atomic_load_explicit(&fr->epoch, memory_order_relaxed);
+        if (e1 == e2) return e1;
+    }
+    if (sy) rw_reader_enter(sy);
+    uint32_t e = atomic_load(&fr->epoch);
+    memcpy(dst, st, size);
+    if (sy) rw_reader_exit(sy);
+    return e;
+}
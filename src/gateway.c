@@ -0,0 +1,129 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#define _GNU_SOURCE             // struct ucred (SO_PEERCRED)
+#include "gateway.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "ipc.h"            // ipc_shm_name: segmentos de la partida elegida
+
+static int fill_addr(struct sockaddr_un *addr, const char *path){
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path)) { errno = ENAMETOOLONG; return -1; }
+    strcpy(addr->sun_path, path);
+    return 0;
+}
+
+int gw_listen(const char *path){
+    struct sockaddr_un addr;
+    if (fill_addr(&addr, path) != 0) return -1;
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    unlink(path);               // socket de una corrida anterior
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, MAX_PLAYERS) != 0) {
+        int e = errno; close(fd); errno = e; return -1;
+    }
+    return fd;
+}
+
+// welcome + fds en un solo mensaje
+static int send_welcome(int fd, const gw_welcome_t *wl, const int *fds, int nfds){
+    struct iovec iov = { (void*)wl, sizeof(*wl) };
+    union { char buf[CMSG_SPACE(sizeof(int) * GW_NFDS)]; struct cmsghdr align; } ctl;
+    memset(&ctl, 0, sizeof(ctl));
+    struct msghdr msg = { .msg_iov = &iov, .msg_iovlen = 1 };
+    if (nfds > 0) {
+        msg.msg_control = ctl.buf;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * (size_t)nfds);
+        struct cmsghdr *c = CMSG_FIRSTHDR(&msg);
+        c->cmsg_level = SOL_SOCKET;
+        c->cmsg_type = SCM_RIGHTS;
+        c->cmsg_len = CMSG_LEN(sizeof(int) * (size_t)nfds);
+        memcpy(CMSG_DATA(c), fds, sizeof(int) * (size_t)nfds);
+    }
+    return (sendmsg(fd, &msg, MSG_NOSIGNAL) == (ssize_t)sizeof(*wl)) ? 0 : -1;
+}
+
+int gw_accept(int lfd, int index, unsigned short W, unsigned short H, int timeout_ms,
+              char name[NAME_LEN], pid_t *pid){
+    struct pollfd pfd = { lfd, POLLIN, 0 };
+    int ready = poll(&pfd, 1, timeout_ms);
+    if (ready <= 0) { if (ready == 0) errno = ETIMEDOUT; return -1; }
+    int fd = accept4(lfd, NULL, NULL, SOCK_CLOEXEC);
+    if (fd < 0) return -1;
+
+    // el saludo tiene que llegar enseguida, un cliente mudo no traba el arranque
+    gw_hello_t hello;
+    pfd = (struct pollfd){ fd, POLLIN, 0 };
+    if (poll(&pfd, 1, 1000) <= 0 || recv(fd, &hello, sizeof(hello), 0) != (ssize_t)sizeof(hello)) {
+        close(fd); errno = EPROTO; return -1;
+    }
+    gw_welcome_t wl = { GW_MAGIC, GW_VERSION, index, (int32_t)getpid(), W, H, 0 };
+    if (hello.magic != GW_MAGIC || hello.version != GW_VERSION) {
+        wl.index = -1;
+        send_welcome(fd, &wl, NULL, 0);
+        close(fd); errno = EPROTO; return -1;
+    }
+
+    // el jugador solo lee el estado; sync necesita RW por los semaforos
+    int fds[GW_NFDS];
+    fds[0] = shm_open(ipc_shm_name(SHM_STATE), O_RDONLY, 0);
+    fds[1] = shm_open(ipc_shm_name(SHM_SYNC), O_RDWR, 0);
+    fds[2] = shm_open(ipc_shm_name(SHM_EXT), O_RDWR, 0);      // RW: el lector anota su lugar en el lockwatch
+    int rc = -1;
+    if (fds[0] >= 0 && fds[1] >= 0) {
+        wl.nfds = (fds[2] >= 0) ? 3u : 2u;
+        rc = send_welcome(fd, &wl, fds, (int)wl.nfds);
+    }
+    int e = errno;
+    for (int i = 0; i < GW_NFDS; ++i) if (fds[i] >= 0) close(fds[i]);
+    if (rc != 0) { close(fd); errno = e; return -1; }
+
+    memcpy(name, hello.name, NAME_LEN);
+    name[NAME_LEN - 1] = '\0';
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    *pid = (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0) ? cred.pid : 0;
+    return fd;
+}
+
+int gw_join(const char *path, const char *name, gw_welcome_t *wl, int fds[GW_NFDS]){
+    for (int i = 0; i < GW_NFDS; ++i) fds[i] = -1;
+    struct sockaddr_un addr;
+    if (fill_addr(&addr, path) != 0) return -1;
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) { int e = errno; close(fd); errno = e; return -1; }
+
+    gw_hello_t hello = { GW_MAGIC, GW_VERSION, {0} };
+    snprintf(hello.name, sizeof(hello.name), "%s", name);
+    if (send(fd, &hello, sizeof(hello), MSG_NOSIGNAL) != (ssize_t)sizeof(hello)) { int e = errno; close(fd); errno = e; return -1; }
+
+    // el master puede tardar: registra a los jugadores de a uno
+    struct iovec iov = { wl, sizeof(*wl) };
+    union { char buf[CMSG_SPACE(sizeof(int) * GW_NFDS)]; struct cmsghdr align; } ctl;
+    struct msghdr msg = { .msg_iov = &iov, .msg_iovlen = 1, .msg_control = ctl.buf, .msg_controllen = sizeof(ctl.buf) };
+    ssize_t r;
+    while ((r = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC)) < 0 && errno == EINTR) {}
+    if (r != (ssize_t)sizeof(*wl)) { close(fd); errno = EPROTO; return -1; }
+    for (struct cmsghdr *c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+        if (c->cmsg_level != SOL_SOCKET || c->cmsg_type != SCM_RIGHTS) continue;
+        size_t n = (c->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        if (n > GW_NFDS) n = GW_NFDS;
+        memcpy(fds, CMSG_DATA(c), n * sizeof(int));
+    }
+    if (wl->magic != GW_MAGIC || wl->index < 0 || wl->index >= MAX_PLAYERS || fds[0] < 0 || fds[1] < 0) {
+        for (int i = 0; i < GW_NFDS; ++i) if (fds[i] >= 0) { close(fds[i]); fds[i] = -1; }
+        close(fd); errno = ECONNREFUSED; return -1;
+    }
+    return fd;
+}
@@ -0,0 +1,372 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "host.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "ipc.h"        // segmentos por partida (ipc_set_game)
+#include "rwsem.h"
+#include "engine.h"
+#include "padboard.h"
+#include "lockwatch.h"
+#include "frame.h"
+
+// /game_ext.id de cada partida: dueños del lock (un jugador muerto no traba al hilo ni a su
+// tanda de partidas) y cuadros para espectadores (view -s con CHOMP_GAME=id)
+static const ext_section_t ext_layout[] = {
+    { EXT_SEC_FRAME,     0, 0, sizeof(frame_t)     },
+    { EXT_SEC_LOCKWATCH, 0, 0, sizeof(lockwatch_t) },
+};
+
+// Una partida: lo mismo que el master clasico guarda en variables sueltas
+typedef struct {
+    int        id;
+    state_t   *st;              // NULL: no se pudo arrancar
+    sync_t    *sy;
+    ext_header_t *ext;          // NULL: sin vigilancia del lock ni espectadores
+    lockwatch_t  *lw;
+    frame_t      *frame;
+    padboard_t pad;             // copia privada con borde (padboard.h)
+    int        nplayers;
+    int        fd[MAX_PLAYERS]; // pipe del jugador, -1 si ya no juega
+    pid_t      pid[MAX_PLAYERS];
+    int        pos[MAX_PLAYERS];// posicion de cada jugador en pad
+    uint64_t   last_valid_ms;   // ultima jugada valida (timeout)
+    bool       over;
+} game_t;
+
+// Un hilo atiende las partidas first, first + stride, ...
+typedef struct {
+    const host_cfg_t *cfg;
+    game_t   *games;
+    int       first, stride;
+    pthread_t tid;
+    bool      threaded;         // false: pthread_create fallo
+    unsigned long long polls;   // vueltas de poll
+    unsigned long long moves;   // jugadas leidas
+} worker_t;
+
+static uint64_t now_ms(void){
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+// Seccion de escritor de la partida, como state_lock/state_unlock del master
+static void game_lock(game_t *g){
+    lockwatch_writer_enter(g->sy, g->lw);
+    if (g->frame) frame_write_begin(g->frame);
+}
+static void game_unlock(game_t *g){
+    if (g->frame) frame_write_end(g->frame);
+    rw_writer_exit(g->sy);
+}
+
+// Lanza al jugador i de la partida con CHOMP_GAME=id. Se llama antes de crear los hilos:
+// entre fork y exec el proceso tiene un solo hilo y setenv es seguro
+static void launch_player(game_t *g, int i, const char *path, const char *id, unsigned short W, unsigned short H){
+    int pfd[2];
+    g->fd[i] = -1; g->pid[i] = 0;
+    if (pipe(pfd) != 0){ perror("host: pipe"); return; }
+    // el extremo de lectura no lo hereda ningun otro jugador (de esta u otra partida)
+    fcntl(pfd[0], F_SETFD, FD_CLOEXEC);
+    pid_t c = fork();
+    if (c == 0){
+        close(pfd[0]);
+        if (dup2(pfd[1], STDOUT_FILENO) < 0){ perror("dup2"); _exit(127); }
+        if (pfd[1] != STDOUT_FILENO) close(pfd[1]);
+        setenv(IPC_GAME_ENV, id, 1);
+        // lock pelado: game_lock es del host (recuperacion, epoch de los espectadores)
+        rw_writer_enter(g->sy);
+        g->st->players[i].player_pid = getpid();
+        rw_writer_exit(g->sy);
+        char wbuf[16], hbuf[16];
+        snprintf(wbuf, sizeof(wbuf), "%u", (unsigned)W);
+        snprintf(hbuf, sizeof(hbuf), "%u", (unsigned)H);
+        execlp(path, "player", wbuf, hbuf, NULL);
+        perror("exec player"); _exit(127);
+    }
+    close(pfd[1]);
+    if (c < 0){ perror("host: fork player"); close(pfd[0]); return; }
+    g->fd[i] = pfd[0];
+    g->pid[i] = c;
+}
+
+// Crea los segmentos de la partida k, llena el tablero y lanza sus jugadores
+static int game_open(game_t *g, const host_cfg_t *cfg, int k){
+    unsigned short W = cfg->width, H = cfg->height;
+    char id[16];
+    snprintf(id, sizeof(id), "%d", k);
+    memset(g, 0, sizeof(*g));
+    g->id = k;
+    g->nplayers = cfg->nplayers;
+    for (int i = 0; i < MAX_PLAYERS; ++i) g->fd[i] = -1;
+
+    // segmentos nuevos: los de una corrida anterior pueden tener semaforos tomados
+    ipc_set_game(id);
+    ipc_unlink_all();
+    bool existed = false, created = false;
+    g->st = ipc_create_and_map_state(W, H, &existed);
+    if (!g->st) return -1;
+    g->sy = ipc_create_and_map_sync(&created);
+    if (!g->sy || ipc_init_sync_semaphores(g->sy) != 0 || padboard_init(&g->pad, W, H) != 0){
+        int e = errno;
+        if (g->sy) ipc_unmap_sync(g->sy);
+        ipc_unmap_state(g->st);
+        ipc_unlink_all();
+        g->st = NULL; g->sy = NULL;
+        errno = e;
+        return -1;
+    }
+    g->ext = ipc_create_and_map_ext(ext_layout, sizeof(ext_layout) / sizeof(ext_layout[0]));
+    if (!g->ext) fprintf(stderr, "host: partida %d sin /game_ext (sin vigilancia del lock ni espectadores): %s\n",
+                         k, strerror(errno));
+    g->lw = ext_section(g->ext, EXT_SEC_LOCKWATCH, sizeof(lockwatch_t));
+    if (g->lw) g->lw->master_pid = getpid();
+    g->frame = ext_section(g->ext, EXT_SEC_FRAME, sizeof(frame_t));
+    if (g->frame) frame_reset(g->frame, getpid());
+
+    state_t *st = g->st;
+    game_lock(g);
+    st->width = W; st->height = H;
+    st->num_players = (unsigned)g->nplayers;
+    st->game_over = false;
+    for (int i = 0; i < g->nplayers; ++i){
+        memset(&st->players[i], 0, sizeof(player_t));
+        snprintf(st->players[i].name, NAME_LEN, "P%d", i);
+    }
+    engine_fill_board(st->board, W, H, cfg->seed + (unsigned)k, 1);
+    game_unlock(g);
+
+    for (int i = 0; i < g->nplayers; ++i) launch_player(g, i, cfg->players[i], id, W, H);
+
+    int px[MAX_PLAYERS], py[MAX_PLAYERS];
+    engine_distribute_positions(g->nplayers, W, H, px, py);
+    game_lock(g);
+    for (int i = 0; i < g->nplayers; ++i){
+        st->players[i].player_pid = g->pid[i];
+        st->players[i].blocked = (g->fd[i] < 0);
+    }
+    engine_place_players(st->board, W, st->players, g->nplayers, px, py);
+    game_unlock(g);
+    padboard_load(&g->pad, st->board);
+    for (int i = 0; i < g->nplayers; ++i) g->pos[i] = padboard_idx(&g->pad, px[i], py[i]);
+    return 0;
+}
+
+// Saca al jugador i: bloqueado en el estado y sin pipe
+static void game_drop(game_t *g, int i){
+    game_lock(g);
+    g->st->players[i].blocked = true;
+    game_unlock(g);
+    if (g->fd[i] >= 0){ close(g->fd[i]); g->fd[i] = -1; }
+}
+
+// Fin de partida: game_over y G[i] para todos, asi cada jugador lo ve y termina
+static void game_finish(game_t *g){
+    game_lock(g);
+    g->st->game_over = true;
+    game_unlock(g);
+    for (int i = 0; i < g->nplayers; ++i){
+        sem_post(&g->sy->G[i]);
+        if (g->fd[i] >= 0){ close(g->fd[i]); g->fd[i] = -1; }
+    }
+    g->over = true;
+}
+
+// Bloquea a los que se quedaron sin salida y termina la partida si no queda nadie
+static void game_check(game_t *g){
+    int active = 0;
+    for (int i = 0; i < g->nplayers; ++i){
+        if (g->fd[i] < 0) continue;
+        if (!padboard_has_valid_move(&g->pad, g->pos[i])) game_drop(g, i);
+        else active++;
+    }
+    if (active == 0) game_finish(g);
+}
+
+// Habilita la primera jugada de cada jugador
+static void game_start(game_t *g){
+    g->last_valid_ms = now_ms();
+    for (int i = 0; i < g->nplayers; ++i)
+        if (g->fd[i] >= 0) sem_post(&g->sy->G[i]);
+    game_check(g);
+}
+
+// Aplica la jugada dir del jugador i y, si puede seguir, le habilita la proxima
+static void game_move(game_t *g, int i, unsigned char dir){
+    player_t *p = &g->st->players[i];
+    int j = padboard_target(&g->pad, g->pos[i], dir);
+    game_lock(g);
+    if (j >= 0) engine_commit_move(g->st->board, g->pad.width, p, i, padboard_flat(&g->pad, j));
+    else engine_reject_move(p);
+    game_unlock(g);
+    if (j >= 0){
+        g->pad.cells[j] = -i;
+        g->pos[i] = j;
+        g->last_valid_ms = now_ms();
+    }
+    if (padboard_has_valid_move(&g->pad, g->pos[i])) sem_post(&g->sy->G[i]);
+    else game_drop(g, i);
+}
+
+// Lee lo que haya en el pipe del jugador i (una jugada por byte)
+static void game_read(worker_t *w, game_t *g, int i){
+    unsigned char dir;
+    ssize_t r = read(g->fd[i], &dir, 1);
+    if (r == 1){
+        w->moves++;
+        game_move(g, i, dir);
+    } else if (r == 0 || errno != EINTR){
+        // eof o error: el jugador se fue. Si murio con E o D tomados se limpia antes de seguir
+        lockwatch_sweep(g->sy, g->lw);
+        game_drop(g, i);
+    }
+    game_check(g);
+}
+
+static void *worker_main(void *arg){
+    worker_t *w = arg;
+    const host_cfg_t *cfg = w->cfg;
+    int mine = (cfg->ngames - w->first + w->stride - 1) / w->stride;
+    size_t cap = (size_t)mine * (size_t)cfg->nplayers;
+    struct pollfd *pfd = malloc((cap ? cap : 1) * sizeof(*pfd));
+    int *who = malloc((cap ? cap : 1) * sizeof(*who));          // g * MAX_PLAYERS + i
+    if (!pfd || !who){
+        perror("host: malloc");
+        free(pfd); free(who);
+        for (int g = w->first; g < cfg->ngames; g += w->stride)
+            if (w->games[g].st && !w->games[g].over) game_finish(&w->games[g]);
+        return NULL;
+    }
+
+    for (int g = w->first; g < cfg->ngames; g += w->stride)
+        if (w->games[g].st) game_start(&w->games[g]);
+
+    while (true){
+        // pipes vivos de las partidas en curso; el poll espera hasta el timeout mas proximo
+        uint64_t now = now_ms();
+        int n = 0, wait = -1;
+        bool running = false;
+        for (int g = w->first; g < cfg->ngames; g += w->stride){
+            game_t *gm = &w->games[g];
+            if (!gm->st || gm->over) continue;
+            if (cfg->timeout_s > 0){
+                uint64_t end = gm->last_valid_ms + (uint64_t)cfg->timeout_s * 1000u;
+                if (now >= end){ game_finish(gm); continue; }
+                if (wait < 0 || end - now < (uint64_t)wait) wait = (int)(end - now);
+            }
+            running = true;
+            for (int i = 0; i < gm->nplayers; ++i){
+                if (gm->fd[i] < 0) continue;
+                pfd[n] = (struct pollfd){ gm->fd[i], POLLIN, 0 };
+                who[n++] = g * MAX_PLAYERS + i;
+            }
+        }
+        if (!running) break;
+
+        int ready = poll(pfd, (nfds_t)n, wait);
+        w->polls++;
+        if (ready < 0){
+            if (errno == EINTR) continue;
+            perror("host: poll");
+            for (int g = w->first; g < cfg->ngames; g += w->stride)
+                if (w->games[g].st && !w->games[g].over) game_finish(&w->games[g]);
+            break;
+        }
+        for (int k = 0; k < n && ready > 0; ++k){
+            if (pfd[k].revents == 0) continue;
+            ready--;
+            game_t *gm = &w->games[who[k] / MAX_PLAYERS];
+            int i = who[k] % MAX_PLAYERS;
+            // la partida pudo terminar (o el jugador salir) antes en esta misma vuelta
+            if (gm->over || gm->fd[i] != pfd[k].fd) continue;
+            game_read(w, gm, i);
+        }
+    }
+    free(pfd);
+    free(who);
+    return NULL;
+}
+
+int host_run(const host_cfg_t *cfg){
+    game_t *games = calloc((size_t)cfg->ngames, sizeof(*games));
+    if (!games){ perror("host: malloc"); return -1; }
+
+    // todas las partidas se preparan y lanzan antes de crear los hilos
+    int started = 0;
+    for (int k = 0; k < cfg->ngames; ++k){
+        if (game_open(&games[k], cfg, k) == 0) started++;
+        else fprintf(stderr, "host: la partida %d no arranco: %s\n", k, strerror(errno));
+    }
+    if (started == 0){ free(games); ipc_set_game(getenv(IPC_GAME_ENV)); return -1; }
+
+    int nw = cfg->nworkers < cfg->ngames ? cfg->nworkers : cfg->ngames;
+    worker_t workers[HOST_MAX_WORKERS];
+    uint64_t t0 = now_ms();
+    for (int k = 0; k < nw; ++k){
+        workers[k] = (worker_t){ .cfg = cfg, .games = games, .first = k, .stride = nw };
+        int rc = pthread_create(&workers[k].tid, NULL, worker_main, &workers[k]);
+        workers[k].threaded = (rc == 0);
+        // si el hilo no arranco, sus partidas las juega el hilo principal al final
+        if (rc != 0) fprintf(stderr, "host: pthread_create: %s\n", strerror(rc));
+    }
+    for (int k = 0; k < nw; ++k){
+        if (workers[k].threaded) pthread_join(workers[k].tid, NULL);
+        else worker_main(&workers[k]);
+    }
+    uint64_t elapsed_ms = now_ms() - t0;
+
+    for (int k = 0; k < cfg->ngames; ++k)
+        for (int i = 0; i < games[k].nplayers; ++i)
+            if (games[k].pid[i] > 0){ int stc = 0; waitpid(games[k].pid[i], &stc, 0); }
+
+    // Resumen
+    unsigned long long moves = 0, polls = 0;
+    unsigned wins[MAX_PLAYERS] = {0};
+    for (int k = 0; k < nw; ++k){ moves += workers[k].moves; polls += workers[k].polls; }
+    printf("\n=== Host: %d partidas, %d hilos, %d jugadores por partida ===\n",
+           started, nw, cfg->nplayers);
+    for (int k = 0; k < cfg->ngames; ++k){
+        game_t *g = &games[k];
+        if (!g->st) continue;
+        int w = engine_winner(g->st->players, g->nplayers);
+        if (w >= 0){
+            wins[w]++;
+            printf("partida %d: ganador P%d score=%u\n", k, w, g->st->players[w].score);
+        } else {
+            printf("partida %d: ganador ninguno\n", k);
+        }
+    }
+    for (int i = 0; i < cfg->nplayers; ++i) printf("Jugador P%d: %u victorias\n", i, wins[i]);
+    double secs = (double)elapsed_ms / 1e3;
+    printf("%llu jugadas en %.3f s (%.0f jugadas/s), %.2f jugadas por poll\n",
+           moves, secs, secs > 0 ? (double)moves / secs : 0.0,
+           polls ? (double)moves / (double)polls : 0.0);
+
+    // limpieza: cada partida borra sus segmentos
+    for (int k = 0; k < cfg->ngames; ++k){
+        game_t *g = &games[k];
+        if (!g->st) continue;
+        char id[16];
+        snprintf(id, sizeof(id), "%d", k);
+        padboard_free(&g->pad);
+        ipc_unmap_ext(g->ext);
+        ipc_unmap_sync(g->sy);
+        ipc_unmap_state(g->st);
+        ipc_set_game(id);
+        ipc_unlink_all();
+    }
+    ipc_set_game(getenv(IPC_GAME_ENV));
+    free(games);
+    return 0;
+}
@@ -11,6 +11,7 @@
 #include <string.h>
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 // Devuelve el tamaño total de /game_state header y tablero
 size_t ipc_state_size(unsigned short w, unsigned short h) {
@@ -18,6 +19,57 @@ size_t ipc_state_size(unsigned short w, unsigned short h) {
     return sizeof(state_t) + (size_t)w * (size_t)h * sizeof(int);
 }
 
+// Mapeos de tamaño variable hechos por este proceso: al desmapear se usa el tamaño que se
+// mapeo de verdad y no uno deducido del contenido (que otro proceso puede haber cambiado).
+// Crece de a poco: el master multipartida (host.h) mapea un estado por partida
+typedef struct { const void *addr; size_t size; } mapping_t;
+static mapping_t *mappings = NULL;
+static size_t     nmappings = 0;
+
+static void remember(const void *p, size_t sz) {
+    for (size_t i = 0; i < nmappings; ++i)
+        if (!mappings[i].addr) { mappings[i].addr = p; mappings[i].size = sz; return; }
+    size_t n = nmappings ? nmappings * 2 : 8;
+    mapping_t *m = realloc(mappings, n * sizeof(*m));
+    if (!m) return;             // sin registro se desmapea con el tamaño del header
+    memset(m + nmappings, 0, (n - nmappings) * sizeof(*m));
+    m[nmappings].addr = p; m[nmappings].size = sz;
+    mappings = m; nmappings = n;
+}
+
+// Devuelve el tamaño registrado (fallback si no estaba) y lo borra
+static size_t forget(const void *p, size_t fallback) {
+    for (size_t i = 0; i < nmappings; ++i)
+        if (mappings[i].addr == p) { mappings[i].addr = NULL; return mappings[i].size; }
+    return fallback;
+}
+
+// Nombres de los segmentos: la base o base.id si hay una partida elegida
+static char game_id[32];
+static bool game_id_loaded = false;
+static char name_state[64], name_sync[64], name_ext[64];
+
+static void build_names(void) {
+    const char *sep = game_id[0] ? "." : "";
+    snprintf(name_state, sizeof(name_state), "%s%s%s", SHM_STATE, sep, game_id);
+    snprintf(name_sync,  sizeof(name_sync),  "%s%s%s", SHM_SYNC,  sep, game_id);
+    snprintf(name_ext,   sizeof(name_ext),   "%s%s%s", SHM_EXT,   sep, game_id);
+    game_id_loaded = true;
+}
+
+void ipc_set_game(const char *id) {
+    snprintf(game_id, sizeof(game_id), "%s", id ? id : "");
+    build_names();
+}
+
+const char *ipc_shm_name(const char *base) {
+    if (!game_id_loaded) ipc_set_game(getenv(IPC_GAME_ENV));
+    if (strcmp(base, SHM_STATE) == 0) return name_state;
+    if (strcmp(base, SHM_SYNC) == 0)  return name_sync;
+    if (strcmp(base, SHM_EXT) == 0)   return name_ext;
+    return base;
+}
+
 // helpers internos
 static int create_or_open(const char *name, bool *created) {
     if (created) *created = false;
@@ -36,24 +88,26 @@ static void *map_fd(int fd, size_t sz) {
 // /game_state
 state_t* ipc_create_and_map_state(unsigned short w, unsigned short h, bool *existed) {
     bool created = false;
-    int fd = create_or_open(SHM_STATE, &created);
+    int fd = create_or_open(ipc_shm_name(SHM_STATE), &created);
     if (fd < 0) return NULL;
 
     size_t sz = ipc_state_size(w, h);
     if (ftruncate(fd, (off_t)sz) != 0) {
         int e = errno; close(fd);
-        if (created) shm_unlink(SHM_STATE);
+        if (created) shm_unlink(ipc_shm_name(SHM_STATE));
         errno = e; return NULL;
     }
     state_t *st = (state_t*)map_fd(fd, sz);
     if (!st) {
-        if (created) shm_unlink(SHM_STATE);
+        if (created) shm_unlink(ipc_shm_name(SHM_STATE));
         return NULL;
     }
+    remember(st, sz);
 
     if (created) {
-        // Inicializa header y tablero en 0
-        memset(st, 0, sz);
+        // Inicializa el header en 0. El tablero ya viene en 0 (ftruncate de una shm nueva)
+        // y no se toca: en tableros enormes recorrerlo aca duplicaria el costo del llenado
+        memset(st, 0, sizeof(state_t));
         st->width = w;
         st->height = h;
         st->num_players = 0;
@@ -64,28 +118,30 @@ state_t* ipc_create_and_map_state(unsigned short w, unsigned short h, bool *exis
     return st;
 }
 
+// Mapea /game_state a partir de un fd ya abierto (lo cierra). El tamaño sale de fstat
+state_t* ipc_map_state_fd(int fd, bool writable) {
+    struct stat stbuf;
+    if (fstat(fd, &stbuf) != 0) { int e = errno; close(fd); errno = e; return NULL; }
+    if ((size_t)stbuf.st_size < sizeof(state_t)) { close(fd); errno = EINVAL; return NULL; }
+    int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void *p = mmap(NULL, (size_t)stbuf.st_size, prot, MAP_SHARED, fd, 0);
+    int e = errno; close(fd); errno = e;
+    if (p == MAP_FAILED) return NULL;
+    remember(p, (size_t)stbuf.st_size);
+    return (state_t*)p;
+}
+
 // Abre /game_state existente y lo mapea
 state_t* ipc_open_and_map_state(void) {
     // 1) Intentar RW (para cuando el master es el nuestro y permite escritura)
-    int fd = shm_open(SHM_STATE, O_RDWR, 0);
-    if (fd >= 0) {
-        struct stat stbuf;
-        if (fstat(fd, &stbuf) != 0) { int e = errno; close(fd); errno = e; return NULL; }
-        void *p = mmap(NULL, (size_t)stbuf.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-        int e = errno; close(fd); errno = e;
-        return (p == MAP_FAILED) ? NULL : (state_t*)p;
-    }
+    int fd = shm_open(ipc_shm_name(SHM_STATE), O_RDWR, 0);
+    if (fd >= 0) return ipc_map_state_fd(fd, true);
 
     // 2) Si falló por permisos (caso master cátedra)
     if (errno == EACCES || errno == EPERM) {
-        fd = shm_open(SHM_STATE, O_RDONLY, 0);
+        fd = shm_open(ipc_shm_name(SHM_STATE), O_RDONLY, 0);
         if (fd < 0) return NULL;
-
-        struct stat stbuf;
-        if (fstat(fd, &stbuf) != 0) { int e = errno; close(fd); errno = e; return NULL; }
-        void *p = mmap(NULL, (size_t)stbuf.st_size, PROT_READ, MAP_SHARED, fd, 0);
-        int e = errno; close(fd); errno = e;
-        return (p == MAP_FAILED) ? NULL : (state_t*)p;
+        return ipc_map_state_fd(fd, false);
     }
 
     // 3) Otros errores
@@ -95,30 +151,29 @@ state_t* ipc_open_and_map_state(void) {
 
 void ipc_unmap_state(state_t *st) {
     if (!st) return;
-    // Para desmapear necesitamos el tamaño, lo inferimos del header
-    size_t sz = ipc_state_size(st->width, st->height);
-    munmap(st, sz);
+    // el tamaño es el que se mapeo (fstat o W x H al crear), no el que dice el header ahora
+    munmap(st, forget(st, ipc_state_size(st->width, st->height)));
 }
 
 int ipc_unlink_state(void) {
-    return shm_unlink(SHM_STATE);
+    return shm_unlink(ipc_shm_name(SHM_STATE));
 }
 
 // /game_sync
 sync_t* ipc_create_and_map_sync(bool *created) {
     bool was_created = false;
-    int fd = create_or_open(SHM_SYNC, &was_created);
+    int fd = create_or_open(ipc_shm_name(SHM_SYNC), &was_created);
     if (fd < 0) return NULL;
 
     if (ftruncate(fd, (off_t)sizeof(sync_t)) != 0) {
         int e = errno; close(fd);
-        if (was_created) shm_unlink(SHM_SYNC);
+        if (was_created) shm_unlink(ipc_shm_name(SHM_SYNC));
         errno = e; return NULL;
     }
 
     sync_t *sy = (sync_t*)map_fd(fd, sizeof(sync_t));
     if (!sy) {
-        if (was_created) shm_unlink(SHM_SYNC);
+        if (was_created) shm_unlink(ipc_shm_name(SHM_SYNC));
         return NULL;
     }
 
@@ -127,10 +182,17 @@ sync_t* ipc_create_and_map_sync(bool *created) {
     return sy;
 }
 
+sync_t* ipc_map_sync_fd(int fd) {
+    struct stat stbuf;
+    if (fstat(fd, &stbuf) != 0) { int e = errno; close(fd); errno = e; return NULL; }
+    if ((size_t)stbuf.st_size < sizeof(sync_t)) { close(fd); errno = EINVAL; return NULL; }
+    return (sync_t*)map_fd(fd, sizeof(sync_t));
+}
+
 sync_t* ipc_open_and_map_sync(void) {
-    int fd = shm_open(SHM_SYNC, O_RDWR, 0660);
+    int fd = shm_open(ipc_shm_name(SHM_SYNC), O_RDWR, 0660);
     if (fd < 0) return NULL;
-    return (sync_t*)map_fd(fd, sizeof(sync_t));
+    return ipc_map_sync_fd(fd);
 }
 
 void ipc_unmap_sync(sync_t *sy) {
@@ -138,7 +200,84 @@ void ipc_unmap_sync(sync_t *sy) {
 }
 
 int ipc_unlink_sync(void) {
-    return shm_unlink(SHM_SYNC);
+    return shm_unlink(ipc_shm_name(SHM_SYNC));
+}
+
+// /game_ext
+ext_header_t* ipc_create_and_map_ext(const ext_section_t *want, unsigned n) {
+    if (n > EXT_MAX_SECTIONS) { errno = EINVAL; return NULL; }
+
+    // offsets alineados a linea de cache, en el orden pedido
+    ext_section_t secs[EXT_MAX_SECTIONS];
+    uint64_t off = ((uint64_t)sizeof(ext_header_t) + EXT_ALIGN - 1u) & ~(uint64_t)(EXT_ALIGN - 1u);
+    for (unsigned i = 0; i < n; ++i) {
+        secs[i] = (ext_section_t){ want[i].id, 0, off, want[i].size };
+        off = (off + want[i].size + EXT_ALIGN - 1u) & ~(uint64_t)(EXT_ALIGN - 1u);
+    }
+
+    // siempre un segmento nuevo: quien tenga mapeado el de una corrida anterior sigue con
+    // su copia y nunca ve cambiar el layout (ni un ftruncate) debajo suyo
+    shm_unlink(ipc_shm_name(SHM_EXT));
+    int fd = shm_open(ipc_shm_name(SHM_EXT), O_RDWR | O_CREAT | O_EXCL, 0660);
+    if (fd < 0) return NULL;
+    if (ftruncate(fd, (off_t)off) != 0) {
+        int e = errno; close(fd); shm_unlink(ipc_shm_name(SHM_EXT)); errno = e; return NULL;
+    }
+    ext_header_t *h = (ext_header_t*)map_fd(fd, (size_t)off);
+    if (!h) { shm_unlink(ipc_shm_name(SHM_EXT)); return NULL; }
+
+    // el segmento viene en 0 (ftruncate de una shm nueva): las secciones arrancan limpias
+    h->version = EXT_VERSION;
+    h->header_size = (uint32_t)sizeof(ext_header_t);
+    h->nsections = n;
+    h->total_size = off;
+    h->master_pid = getpid();
+    memcpy(h->sections, secs, sizeof(ext_section_t) * n);
+    atomic_store_explicit(&h->magic, EXT_MAGIC, memory_order_release);
+    remember(h, (size_t)off);
+    return h;
+}
+
+// Valida el header antes de entregar el segmento: magic, version y que la tabla entre en
+// lo que realmente se mapeo
+static bool ext_valid(const ext_header_t *h, size_t mapped) {
+    if (atomic_load_explicit(&h->magic, memory_order_acquire) != EXT_MAGIC) return false;
+    if (h->version != EXT_VERSION || h->header_size != sizeof(ext_header_t)) return false;
+    if (h->nsections > EXT_MAX_SECTIONS || h->total_size > mapped) return false;
+    for (uint32_t i = 0; i < h->nsections; ++i) {
+        const ext_section_t *s = &h->sections[i];
+        if (s->offset % EXT_ALIGN != 0 || s->offset < sizeof(ext_header_t)) return false;
+        if (s->offset > h->total_size || s->size > h->total_size - s->offset) return false;
+    }
+    return true;
+}
+
+ext_header_t* ipc_map_ext_fd(int fd, bool writable) {
+    struct stat stbuf;
+    if (fstat(fd, &stbuf) != 0) { int e = errno; close(fd); errno = e; return NULL; }
+    size_t sz = (size_t)stbuf.st_size;
+    if (sz < sizeof(ext_header_t)) { close(fd); errno = EPROTO; return NULL; }
+    int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void *p = mmap(NULL, sz, prot, MAP_SHARED, fd, 0);
+    int e = errno; close(fd); errno = e;
+    if (p == MAP_FAILED) return NULL;
+    if (!ext_valid((const ext_header_t*)p, sz)) { munmap(p, sz); errno = EPROTO; return NULL; }
+    remember(p, sz);
+    return (ext_header_t*)p;
+}
+
+ext_header_t* ipc_open_and_map_ext(bool writable) {
+    int fd = shm_open(ipc_shm_name(SHM_EXT), writable ? O_RDWR : O_RDONLY, 0);
+    if (fd < 0) return NULL;
+    return ipc_map_ext_fd(fd, writable);
+}
+
+void ipc_unmap_ext(const ext_header_t *h) {
+    if (h) munmap((void*)h, forget(h, (size_t)h->total_size));
+}
+
+int ipc_unlink_ext(void) {
+    return shm_unlink(ipc_shm_name(SHM_EXT));
 }
 
 // Inicializa todos los semaforos 
@@ -0,0 +1,151 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "lockwatch.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include "rwsem.h"
+
+lw_slot_t *lw_self = NULL;
+
+// Un hijo del master que murio queda zombie hasta el waitpid y kill(pid, 0) lo da por vivo:
+// se mira el estado en /proc (si no hay /proc, vale lo que diga kill)
+static bool alive(pid_t pid){
+    if (pid <= 0 || (kill(pid, 0) != 0 && errno == ESRCH)) return false;
+    char path[32], buf[256];
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    FILE *f = fopen(path, "r");
+    if (!f) return errno != ENOENT;
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+    const char *p = strrchr(buf, ')');          // el nombre puede tener espacios y parentesis
+    return !(p && p[1] == ' ' && (p[2] == 'Z' || p[2] == 'X'));
+}
+
+// Vida del dueño de un lugar con un pid del espacio del master. Un externo sin pid de
+// SO_PEERCRED no se puede verificar: cuenta como vivo
+static bool slot_alive(const lockwatch_t *w, const lw_slot_t *s){
+    int32_t peer = atomic_load(&s->peer);
+    if (peer <= 0) return alive(atomic_load(&s->pid));
+    if (peer > MAX_PLAYERS) return true;
+    pid_t pid = atomic_load(&w->peer_pid[peer - 1]);
+    return pid <= 0 || alive(pid);
+}
+
+int lockwatch_attach(lockwatch_t *w, int peer){
+    pid_t me = getpid();
+    for (int i = 0; i < LW_SLOTS; ++i){
+        lw_slot_t *s = &w->slots[i];
+        pid_t old = atomic_load(&s->pid);
+        // un muerto que quedo a mitad del protocolo es evidencia para el master: no se pisa
+        bool reusable = old == 0 || (!slot_alive(w, s) && atomic_load(&s->phase) == LW_OUT &&
+                                     atomic_load(&s->counted) == 0);
+        if (!reusable || !atomic_compare_exchange_strong(&s->pid, &old, me)) continue;
+        atomic_store(&s->phase, LW_OUT);
+        atomic_store(&s->counted, 0u);
+        atomic_store(&s->peer, (peer >= 0 && peer < MAX_PLAYERS) ? peer + 1 : 0);
+        lw_self = s;
+        return i;
+    }
+    return -1;
+}
+
+void lockwatch_set_peer(lockwatch_t *w, int i, pid_t pid){
+    if (w && i >= 0 && i < MAX_PLAYERS) atomic_store(&w->peer_pid[i], pid);
+}
+
+// sem_timedwait usa CLOCK_REALTIME
+static int timed_wait(sem_t *sem, int ms){
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += ms / 1000;
+    ts.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) { ts.tv_sec++; ts.tv_nsec -= 1000000000L; }
+    int r;
+    while ((r = sem_timedwait(sem, &ts)) != 0 && errno == EINTR) {}
+    return r;
+}
+
+static void report(lockwatch_t *w, const char *what, pid_t pid){
+    atomic_fetch_add(&w->recoveries, 1u);
+    if (pid > 0) fprintf(stderr, "master: lock recuperado: %s (pid %d muerto)\n", what, (int)pid);
+    else fprintf(stderr, "master: lock recuperado: %s\n", what);
+}
+
+// sem no llega y quien lo tiene es un lector muerto: ningun vivo lo tiene (HOLD) y hay un
+// muerto en WAIT o HOLD (pudo morir justo despues de tomarlo, antes de anotarlo). En ese caso
+// el llamador hereda el semaforo tal como quedo (sin post) y devuelve true.
+// Sin lugares de muertos no se toca nada: el dueño puede ser un lector sin vigilancia
+static bool inherit_from_dead(lockwatch_t *w, sem_t *sem, uint32_t wait, uint32_t hold, const char *what){
+    int v = 1;
+    sem_getvalue(sem, &v);
+    if (v > 0) return false;
+    pid_t dead = 0;
+    for (int i = 0; i < LW_SLOTS; ++i){
+        lw_slot_t *s = &w->slots[i];
+        pid_t pid = atomic_load(&s->pid);
+        uint32_t ph = atomic_load(&s->phase);
+        if (pid == 0 || (ph != wait && ph != hold)) continue;
+        if (slot_alive(w, s)) { if (ph == hold) return false; }
+        else dead = pid;
+    }
+    if (!dead) return false;
+    for (int i = 0; i < LW_SLOTS; ++i){
+        lw_slot_t *s = &w->slots[i];
+        uint32_t ph = atomic_load(&s->phase);
+        if ((ph == wait || ph == hold) && !slot_alive(w, s)) atomic_store(&s->phase, LW_OUT);
+    }
+    report(w, what, dead);
+    return true;
+}
+
+static void take(sem_t *sem, lockwatch_t *w, uint32_t wait, uint32_t hold, const char *what){
+    while (timed_wait(sem, LW_TIMEOUT_MS) != 0)
+        if (inherit_from_dead(w, sem, wait, hold, what)) return;
+}
+
+// Con E tomado y sin D en manos del llamador: descuenta de F a los lectores muertos y, si no
+// queda ninguno y D sigue tomado, lo libera (con F == 0 nadie lo tiene legitimamente: pudo
+// quedar de un primer lector que murio adentro o de un ultimo lector que murio saliendo)
+static void fix_readers(sync_t *sy, lockwatch_t *w){
+    for (int i = 0; i < LW_SLOTS; ++i){
+        lw_slot_t *s = &w->slots[i];
+        pid_t pid = atomic_load(&s->pid);
+        if (pid == 0 || atomic_load(&s->counted) == 0 || slot_alive(w, s)) continue;
+        if (sy->F > 0) sy->F--;
+        atomic_store(&s->counted, 0u);
+        atomic_store(&s->phase, LW_OUT);
+        report(w, "lector contado en F", pid);
+    }
+    int d = 1;
+    sem_getvalue(&sy->D, &d);
+    if (sy->F == 0 && d <= 0){
+        sem_post(&sy->D);
+        report(w, "D sin lectores vivos", 0);
+    }
+}
+
+void lockwatch_writer_enter(sync_t *sy, lockwatch_t *w){
+    if (!w) { rw_writer_enter(sy); return; }
+    take(&sy->C, w, LW_WAIT_C, LW_HOLD_C, "C");
+    // con C tomado no entran lectores nuevos: si D no llega, revisar a los que estan adentro
+    while (timed_wait(&sy->D, LW_TIMEOUT_MS) != 0){
+        take(&sy->E, w, LW_WAIT_E, LW_HOLD_E, "E");
+        fix_readers(sy, w);
+        sem_post(&sy->E);
+    }
+}
+
+void lockwatch_sweep(sync_t *sy, lockwatch_t *w){
+    if (!w) return;
+    take(&sy->E, w, LW_WAIT_E, LW_HOLD_E, "E");
+    fix_readers(sy, w);
+    sem_post(&sy->E);
+}
@@ -10,6 +10,7 @@
 #include <time.h>
 #include <unistd.h>
 #include <sys/wait.h>
+#include <sys/resource.h> // getrusage para el CSV de carga
 #include <string.h>
 #include <signal.h>
 #include <errno.h>
@@ -17,14 +18,38 @@
 #include <stdint.h>
 #include "ipc.h"    // SHM: /game_state y /game_sync
 #include "rwsem.h"  // RW: semaforos de lectura/escritura
+#include "engine.h" // reglas del juego
+#include "gateway.h" // jugadores externos por socket unix
+#include "spinwait.h" // espera adaptativa de B (CHOMP_SPIN)
+#include "affinity.h" // -c/-f: CPU y SCHED_FIFO por proceso
+#include "host.h"     // -n/-j: muchas partidas en este proceso
+#include "trace.h"    // CHOMP_TRACE: timeline de master, vista y jugadores
+#include "perfphase.h" // -P: contadores de hardware por fase
 #include <getopt.h>
 
+// Plazo por jugada (-m): si el jugador no contesta a tiempo cuenta como invalida, el plazo
+// se rearma y su respuesta tardia se descarta. Con MAX_PLAYERS=9 alcanza con recorrer los plazos
+#define DEADLINE_MISS_LIMIT 3                   // plazos vencidos en una partida que bloquean
+static int      move_deadline_ms = 0;           // 0 = sin plazo
+static uint64_t deadline_ns[MAX_PLAYERS];       // vencimiento del G[i] pendiente (0 = ninguno)
+static bool     late_reply[MAX_PLAYERS];        // la proxima respuesta ya se conto como invalida
+static unsigned deadline_misses[MAX_PLAYERS];   // total de la corrida, para el reporte
+
 // util
 static int clamp(int v, int lo, int hi){ if (v<lo) return lo; if (v>hi) return hi; return v; }
 static void usage(const char* p){
     fprintf(stderr,
-        "Uso: %s -w ancho -h alto -v ruta_vista -p jugador1 [jugador2 ...] [-d delay_ms] [-t timeout_s] [-s semilla]\n",
-        p);
+        "Uso: %s -w ancho -h alto [-v ruta_vista] -p jugador1 [jugador2 ...] [-d delay_ms] [-t timeout_s] [-s semilla] [-g partidas] [-m plazo_ms] [-u socket -x externos] [-r stats.csv] [-c cpus] [-f prio] [-n partidas -j hilos] [-P]\n"
+        "  sin -v corre sin vista (headless)\n"
+        "  -m plazo por jugada: vencido cuenta como invalida, %d vencidos en una partida bloquean al jugador\n"
+        "  -u/-x espera x jugadores externos que se conectan al socket unix (ver include/gateway.h)\n"
+        "  -g juega esa cantidad de partidas seguidas con los mismos procesos (la partida k usa semilla+k)\n"
+        "  -c fija cada proceso a una CPU: lista 0,1,.. en orden master, vista, jugadores (se repite si es corta) o auto\n"
+        "  -f pasa master, vista y jugadores a SCHED_FIFO con esa prioridad (necesita CAP_SYS_NICE)\n"
+        "  -r agrega una fila CSV con jugadas/s, latencia p50/p99/p999 y CPU de master, vista y jugadores\n"
+        "  -P cuenta ciclos, instrucciones, cache/branch misses y cambios de contexto por fase del bucle (perf_event_open)\n"
+        "  -n juega esa cantidad de partidas a la vez en este proceso, atendidas por -j hilos (sin vista, ver include/host.h)\n",
+        p, DEADLINE_MISS_LIMIT);
 }
 
 // Reloj mide tiempo entre movimientos validos
@@ -34,76 +59,186 @@ static uint64_t now_ms(void){
     uint64_t nsec = (uint64_t)ts.tv_nsec;
     return sec*1000u + nsec/1000000u;
 }
+static uint64_t now_ns(void){
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
 static void sleep_ms(int ms){
     if (ms<=0) return;
     struct timespec ts = { ms/1000, (long)(ms%1000)*1000000L };
     nanosleep(&ts, NULL);
 }
 
-// init helpers
-// Llena todo el tablero con recompensas del 1 al 9 aleatorias
-static void board_fill_random(state_t *st){
-    int W = st->width, H = st->height;
-    for (int y=0; y<H; ++y)
-        for (int x=0; x<W; ++x)
-            st->board[idx_xy(x,y,W)] = 1 + (rand() % 9);
+// Contadores por fase (-P, ver perfphase.h). phase() cambia de fase y devuelve la anterior
+static perfphase_t perf;
+static bool perf_on = false;
+static phase_t phase(phase_t p){ return perf_on ? perfphase_switch(&perf, p) : p; }
+
+// Handshake A/B
+// Notifica a la vista (A) y espera que temrine de imprimir (B)
+// Luego el master aplica el delay si corresponde
+// Sin vista (headless, sin -v) no hay a quien esperar
+static bool view_on = true;
+static spinwait_t spin_b;       // espera de B (CHOMP_SPIN, ver spinwait.h)
+static void repaint(sync_t *sy){
+    if (!view_on) return;
+    uint64_t t0 = trace_begin();
+    phase_t prev = phase(PH_REPAINT);
+    sem_post(&sy->A);
+    while (spinwait_sem(&spin_b, &sy->B) != 0 && errno == EINTR) {}
+    phase(prev);
+    trace_end(TR_REPAINT, t0, -1);
 }
 
+// Espectadores (view -s): cada seccion de escritor sobre el estado avanza el epoch de
+// /game_ext, asi pueden copiar sin lock y dormir hasta el proximo cambio (ver frame.h)
+static frame_t *frame = NULL;
+static lockstats_t *lock_stats = NULL;  // contencion del lock de escritor (shm_tool top)
+
+static lockwatch_t *lock_watch = NULL;  // dueños del rwsem: un lector muerto no traba al master
+static zobrist_t *zob = NULL;           // hash del estado, se actualiza en cada captura
+
+// Secciones de /game_ext que publica este master (el offset lo asigna el arena)
+static const ext_section_t ext_layout[] = {
+    { EXT_SEC_LOG,       0, 0, sizeof(movelog_t)   },
+    { EXT_SEC_FRAME,     0, 0, sizeof(frame_t)     },
+    { EXT_SEC_STATS,     0, 0, sizeof(lockstats_t) },
+    { EXT_SEC_LOCKWATCH, 0, 0, sizeof(lockwatch_t) },
+    { EXT_SEC_ZOBRIST,   0, 0, sizeof(zobrist_t)   },
+};
+static uint64_t writer_t0;     // inicio de la seccion de escritor en curso (traza)
+static phase_t  writer_prev;   // fase a la que se vuelve al soltar el lock (-P)
+static void state_lock(sync_t *sy){
+    writer_t0 = trace_begin();
+    writer_prev = phase(PH_WRITER);
+    if (lock_stats){
+        // D en 0: hay lectores adentro y el escritor va a tener que esperar
+        int d = 1;
+        sem_getvalue(&sy->D, &d);
+        uint64_t t0 = now_ns();
+        lockwatch_writer_enter(sy, lock_watch);
+        lockstats_record(lock_stats, now_ns() - t0, d <= 0);
+    } else {
+        lockwatch_writer_enter(sy, lock_watch);
+    }
+    if (frame) frame_write_begin(frame);
+}
+static void state_unlock(sync_t *sy){
+    if (frame) frame_write_end(frame);
+    rw_writer_exit(sy);
+    phase(writer_prev);
+    trace_end(TR_WRITER, writer_t0, -1);
+}
 
-// Distribuye las posiciones iniciales de N jugadores de forma pareja
-// y con margen similar al borde
-static void distribute_positions(int n, int W, int H, int *px, int *py){
-    int R = 1; while (R*R < n) R++;             // filas
-    int C = (n + R - 1) / R;                    // columnas
-    int stepX = (C > 0) ? (W / (C + 1)) : W;
-    int stepY = (R > 0) ? (H / (R + 1)) : H;
-    int k = 0;
-    for (int r=0; r<R && k<n; ++r)
-        for (int c=0; c<C && k<n; ++c){
-            int x = (c + 1) * stepX; if (x<0) x=0; if (x>=W) x=W-1;
-            int y = (r + 1) * stepY; if (y<0) y=0; if (y>=H) y=H-1;
-            px[k]=x; py[k]=y; ++k;
-        }
+#define GW_JOIN_TIMEOUT_MS 30000         // espera maxima por cada jugador externo
+#define GW_MAX_FAILS       16            // registros fallidos antes de dejar de escuchar
+
+// Modo pool (-g > 1): vista y jugadores se lanzan una vez y juegan todas las partidas.
+// Entre partidas no se publica game_over, los procesos quedan esperando A o G[i]
+// y a un jugador bloqueado no se le cierra el pipe porque vuelve a jugar en la siguiente
+static bool pool_mode = false;
+static bool pending_move[MAX_PLAYERS];  // G[i] habilitado y su jugada todavia sin leer
+
+// Estadisticas de carga (-r): latencia desde que se habilita G[i] hasta leer la jugada
+typedef struct {
+    uint64_t  posted_ns[MAX_PLAYERS];   // cuando se habilito a cada jugador (0 = no medido)
+    uint32_t *lat_us;                   // una muestra por jugada leida
+    size_t    n, cap;
+    uint64_t  run_ns;                   // duracion del bucle principal (suma de todas las partidas)
+    unsigned long long moves;           // jugadas de todas las partidas
+    unsigned  games;
+} load_stats_t;
+
+// Habilita 1 jugada del jugador i y marca el momento si se miden latencias
+static void enable_player(sync_t *sy, load_stats_t *ls, int i){
+    if (ls) ls->posted_ns[i] = now_ns();
+    pending_move[i] = true;
+    if (move_deadline_ms > 0) deadline_ns[i] = now_ns() + (uint64_t)move_deadline_ms * 1000000u;
+    sem_post(&sy->G[i]);
 }
 
-// setea la celda inicial como capturada por el jugador (-id) (no suma score)
-static void paint_initial_positions(state_t *st, int n, const int *px, const int *py){
-    int W = st->width;
-    for (int i=0;i<n;++i){
-        int id = idx_xy(px[i], py[i], W);
-        st->board[id] = -i; // capturada por i (nota: id=0 => celda=0)
-        st->players[i].pos_x = (unsigned short)px[i];
-        st->players[i].pos_y = (unsigned short)py[i];
+// Jugadas recibidas y todavia no atendidas: un jugador puede mandar varias juntas
+// (varios bytes en el pipe o un mensaje del socket con varias direcciones), se atienden de a una
+typedef struct { unsigned char buf[GW_MAX_BATCH]; unsigned head, len; } move_queue_t;
+static move_queue_t moveq[MAX_PLAYERS];
+
+// Como read(fd, dir, 1), pero pasando por la cola del jugador i
+static ssize_t read_move(int fd, int i, unsigned char *dir){
+    move_queue_t *q = &moveq[i];
+    if (q->len == 0){
+        ssize_t r = read(fd, q->buf, sizeof(q->buf));
+        if (r <= 0) return r;
+        q->head = 0; q->len = (unsigned)r;
     }
+    *dir = q->buf[q->head++];
+    q->len--;
+    return 1;
 }
 
-// Handshake A/B
-// Notifica a la vista (A) y espera que temrine de imprimir (B)
-// Luego el master aplica el delay si corresponde
-static void repaint(sync_t *sy){ sem_post(&sy->A); sem_wait(&sy->B); }
-
-// chequear si el jugador tiene algun movimiento valido
-static bool has_valid_move(state_t *st, int i) {
-    int x = (int)st->players[i].pos_x;  // pos actual
-    int y = (int)st->players[i].pos_y;  // pos actual
-    int W = (int)st->width, H = (int)st->height;    // dimensiones tablero
-    for (int d = 0; d < 8; d++) {
-        int nx = x + DX[d];
-        int ny = y + DY[d];
-        if (nx >= 0 && nx < W && ny >= 0 && ny < H) {   // dentro de limites
-            if (st->board[ny * W + nx] > 0) {
-                return true;
-            }
-        }
+// Saca al jugador i de la partida; en modo pool su pipe queda abierto para la siguiente
+static void drop_player(int p_rd[], bool active_fd[], int i){
+    active_fd[i] = false;
+    if (!pool_mode && p_rd[i] >= 0) { close(p_rd[i]); p_rd[i] = -1; }
+}
+
+// El jugador i se fue (eof o error de lectura)
+static void close_player(int p_rd[], bool active_fd[], int i){
+    active_fd[i] = false;
+    pending_move[i] = false;
+    deadline_ns[i] = 0;
+    moveq[i].len = 0;
+    if (p_rd[i] >= 0) { close(p_rd[i]); p_rd[i] = -1; }
+}
+
+static void stats_move_read(load_stats_t *ls, int i){
+    if (!ls || ls->posted_ns[i] == 0) return;
+    if (ls->n == ls->cap){
+        size_t cap = ls->cap ? ls->cap * 2 : 4096;
+        uint32_t *p = realloc(ls->lat_us, cap * sizeof(*p));
+        if (!p) return;             // sin memoria: se pierde la muestra
+        ls->lat_us = p; ls->cap = cap;
     }
-    return false;   // no hay movimientos validos
+    ls->lat_us[ls->n++] = (uint32_t)((now_ns() - ls->posted_ns[i]) / 1000u);
+    ls->posted_ns[i] = 0;
 }
 
-// Lanza la vista 
-static pid_t launch_view(const char *view_path, unsigned short W, unsigned short H){
+static int cmp_u32(const void *a, const void *b){
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// percentil sobre las muestras ya ordenadas
+static uint32_t percentile(const load_stats_t *ls, double p){
+    if (ls->n == 0) return 0;
+    return ls->lat_us[(size_t)(p * (double)(ls->n - 1))];
+}
+
+static double tv_secs(struct timeval tv){ return (double)tv.tv_sec + (double)tv.tv_usec / 1e6; }
+static double ru_secs(const struct rusage *ru){ return tv_secs(ru->ru_utime) + tv_secs(ru->ru_stime); }
+
+// Agrega una fila al CSV de resultados (crea el encabezado si el archivo esta vacio)
+static void write_stats_csv(const char *path, const state_t *st, int delay, const load_stats_t *ls,
+                            double cpu_master, double cpu_view, double cpu_players){
+    FILE *f = fopen(path, "a");
+    if (!f){ perror("master: stats csv"); return; }
+    if (ftell(f) == 0)
+        fprintf(f, "width,height,players,delay_ms,moves,elapsed_s,moves_per_s,p50_us,p99_us,p999_us,cpu_master_s,cpu_view_s,cpu_players_s,games\n");
+    double secs = (double)ls->run_ns / 1e9;
+    fprintf(f, "%u,%u,%u,%d,%llu,%.3f,%.0f,%u,%u,%u,%.3f,%.3f,%.3f,%u\n",
+            st->width, st->height, st->num_players, delay, ls->moves, secs,
+            secs > 0 ? (double)ls->moves / secs : 0.0,
+            percentile(ls, 0.50), percentile(ls, 0.99), percentile(ls, 0.999),
+            cpu_master, cpu_view, cpu_players, ls->games);
+    fclose(f);
+}
+
+// Lanza la vista. La ubicacion (-c/-f) se aplica en el hijo antes del exec para que la
+// herede todo el proceso, incluidos los hilos que cree despues
+static pid_t launch_view(const char *view_path, unsigned short W, unsigned short H, const placement_t *pl, int slot){
     pid_t pid = fork();
     if (pid == 0){
         // hijo vista reemplaza imagen de proceso
+        placement_apply(pl, 0, slot, "vista");
         char wbuf[16], hbuf[16];
         snprintf(wbuf, sizeof(wbuf), "%u", (unsigned)W);
         snprintf(hbuf, sizeof(hbuf), "%u", (unsigned)H);
@@ -116,7 +251,12 @@ static pid_t launch_view(const char *view_path, unsigned short W, unsigned short
 
 // Crea un pipe por jugador y redirige stdout del jugador al extremo de escritura del pipe
 // El master se queda con el extremo de lectura para hacer select(2)
-static void launch_players(int n, char *players[], int p_rd[], pid_t pids[], unsigned short W, unsigned short H){
+// El hijo anota su pid en players[i] antes del exec, asi el jugador encuentra su indice
+// en la primera pasada sin esperar a que el master registre todos los pids.
+// El jugador i va al lugar de ubicacion first_slot + i, fijado antes del exec: asi los hilos
+// que cree (mcts -T) nacen en su CPU y no en la del master
+static void launch_players(state_t *st, sync_t *sy, int n, char *players[], int p_rd[], pid_t pids[], unsigned short W, unsigned short H,
+                           const placement_t *pl, int first_slot){
     for (int i = 0; i < n; ++i){
         int pfd[2]; if (pipe(pfd) != 0){ perror("pipe"); p_rd[i]=-1; pids[i]=0; continue; }
         int rd = pfd[0], wr = pfd[1];
@@ -129,6 +269,14 @@ static void launch_players(int n, char *players[], int p_rd[], pid_t pids[], uns
             for(int j=0; j<i; j++){
                 if(p_rd[j]>=0) close(p_rd[j]);
             }
+            // lock pelado: state_lock es del master (recuperacion, contadores, epoch de frames)
+            // y en el hijo tocaria copias de su estado o el /game_ext justo antes del exec
+            rw_writer_enter(sy);
+            st->players[i].player_pid = getpid();
+            rw_writer_exit(sy);
+            char who[16];
+            snprintf(who, sizeof(who), "P%d", i);
+            placement_apply(pl, 0, first_slot + i, who);
             char idxbuf[16], wbuf[16], hbuf[16];
             snprintf(idxbuf, sizeof(idxbuf), "%d", i);
             snprintf(wbuf,  sizeof(wbuf),  "%u", (unsigned)W);
@@ -147,34 +295,85 @@ static void launch_players(int n, char *players[], int p_rd[], pid_t pids[], uns
 }
 
 
-// Helpers logica del juego
-// Devuelve true si hay al menos 1 celda libre, sirve para detectar bloqueo
-static bool any_free_adjacent(const state_t *st, int x0, int y0){
-    for (int d=0; d<8; ++d){
-        int nx = x0 + DX[d], ny = y0 + DY[d];
-        if (!in_bounds(nx,ny,st->width,st->height)) continue;
-        if (st->board[idx_xy(nx,ny,st->width)] > 0) return true;
+// Cobra los plazos vencidos (-m) como jugadas invalidas; misses[] cuenta los de esta partida
+static void expire_deadlines(state_t *st, sync_t *sy, int nplayers, int p_rd[], bool active_fd[], unsigned misses[]){
+    uint64_t now = now_ns();
+    for (int i = 0; i < nplayers; ++i){
+        if (!active_fd[i] || deadline_ns[i] == 0 || now < deadline_ns[i]) continue;
+        misses[i]++;
+        deadline_misses[i]++;
+        late_reply[i] = true;
+        bool out = misses[i] >= DEADLINE_MISS_LIMIT;
+        state_lock(sy);
+        engine_reject_move(&st->players[i]);
+        if (out) st->players[i].blocked = true;
+        state_unlock(sy);
+        repaint(sy);
+        if (out) { deadline_ns[i] = 0; drop_player(p_rd, active_fd, i); }
+        else deadline_ns[i] = now + (uint64_t)move_deadline_ms * 1000000u;
+    }
+}
+
+// Espera de select: step_ms, recortada al plazo mas proximo
+static struct timeval select_wait(int step_ms, int nplayers, const bool active_fd[]){
+    uint64_t wait_us = (step_ms > 0) ? (uint64_t)step_ms * 1000u : 0;
+    if (wait_us > 0 && move_deadline_ms > 0){
+        uint64_t now = now_ns();
+        for (int i = 0; i < nplayers; ++i){
+            if (!active_fd[i] || deadline_ns[i] == 0) continue;
+            uint64_t left_us = (deadline_ns[i] > now) ? (deadline_ns[i] - now) / 1000u : 0;
+            if (left_us < wait_us) wait_us = left_us;
+        }
     }
-    return false;
+    struct timeval tv = { (time_t)(wait_us / 1000000u), (suseconds_t)(wait_us % 1000000u) };
+    return tv;
+}
+
+// Copia privada del tablero con borde de centinelas (padboard.h). El master es el unico que
+// escribe el tablero, asi que valida jugadas y busca salidas en su copia: sin leer la shm y
+// sin in_bounds por vecino. Si no hay memoria para la copia se usa el tablero de la shm
+static padboard_t vboard;
+static bool vboard_on = false;
+
+static void vboard_load(const state_t *st){ if (vboard_on) padboard_load(&vboard, st->board); }
+
+static void vboard_capture(int x, int y, int id){
+    if (vboard_on) vboard.cells[padboard_idx(&vboard, x, y)] = -id;
+}
+
+static bool has_move(const state_t *st, int x, int y){
+    if (vboard_on) return padboard_has_valid_move(&vboard, padboard_idx(&vboard, x, y));
+    return engine_has_valid_move(st->board, st->width, st->height, x, y);
+}
+
+static bool check_move(const state_t *st, int x, int y, unsigned dir, int *idx){
+    if (!vboard_on) return engine_check_move(st->board, st->width, st->height, x, y, dir, idx) == MOVE_VALID;
+    int j = padboard_target(&vboard, padboard_idx(&vboard, x, y), dir);
+    if (j < 0) return false;
+    *idx = padboard_flat(&vboard, j);
+    return true;
 }
 
 // Bucle principal
 // Atiende 1 solicitud por jugador habilitado antes de pasar al siguiente
 // Cada jugador tiene G[i] como compuerta para enviar un movimiento
 // Se corta por timeout sin movimientos valiods o por quedarse sin jugadores activos
-static void run_round_robin(state_t *st, sync_t *sy,
+// last_game: publica game_over y libera a todos; si no (pool) los jugadores quedan estacionados
+static void run_round_robin(state_t *st, sync_t *sy, movelog_t *lg,
     int nplayers, int step_ms, int timeout_s,
-    int px[], int py[], int p_rd[], pid_t pids[])
+    int px[], int py[], int p_rd[], pid_t pids[], load_stats_t *ls, bool last_game)
 {
+    uint64_t t_start = now_ns();
     bool active_fd[MAX_PLAYERS];    // jugadores con pipe vivo
     for (int i = 0; i < nplayers; ++i)
         active_fd[i] = (p_rd[i] >= 0);
 
     uint64_t last_valid_ms = now_ms();  // marca del ultimo movimiento valido
+    unsigned misses[MAX_PLAYERS] = {0}; // plazos vencidos en esta partida
 
     // seed: habilitar 1 solicitud por jugador activo (sin acumular)
     for (int i = 0; i < nplayers; ++i){
-        if (active_fd[i]) sem_post(&sy->G[i]);
+        if (active_fd[i]) enable_player(sy, ls, i);
     }
 
     while (true) {
@@ -186,20 +385,25 @@ static void run_round_robin(state_t *st, sync_t *sy,
         fd_set rfds; FD_ZERO(&rfds);
         int maxfd = -1;
         int any_active = 0;
+        bool queued = false;                    // jugadas ya leidas esperando turno
         for (int i = 0; i < nplayers; ++i) {
             if (!active_fd[i]) continue;
             FD_SET(p_rd[i], &rfds);
             if (p_rd[i] > maxfd) maxfd = p_rd[i];
             any_active = 1;
+            queued |= (moveq[i].len > 0);
         }
         if (!any_active) break;
 
-        // select con timeout step_ms (delay entre impresiones)
-        struct timeval tv;
-        tv.tv_sec = (time_t)((step_ms > 0) ? (step_ms / 1000) : 0);
-        tv.tv_usec = (suseconds_t)((step_ms > 0) ? ((step_ms % 1000) * 1000) : 0);
+        // select con timeout step_ms (delay entre impresiones) o hasta el proximo plazo
+        struct timeval tv = select_wait(step_ms, nplayers, active_fd);
+        if (queued) { tv.tv_sec = 0; tv.tv_usec = 0; }
 
+        uint64_t t_sel = trace_begin();
+        phase(PH_WAIT);
         int ready = select(maxfd + 1, &rfds, NULL, NULL, &tv);
+        phase(PH_VALIDATE);
+        trace_end(TR_SELECT, t_sel, -1);
         if (ready < 0) {
             if (errno == EINTR) continue;       // reintentar si señal interrumpio
             perror("select");                   // error grave cerrar todo lo activo
@@ -212,64 +416,54 @@ static void run_round_robin(state_t *st, sync_t *sy,
         bool processed[MAX_PLAYERS] = {0};      // quien fue atendido en este ciclo
         bool any_valid_this_cycle = false;      // si hubo algun movimiento valido
 
-        if (ready > 0) {
+        if (ready > 0 || queued) {
             // iterar en orden sobre todos los jugadores con datos listos
             for (int i = 0; i < nplayers; ++i) {
                 if (!active_fd[i]) continue;
-                if (!FD_ISSET(p_rd[i], &rfds)) continue;
+                if (moveq[i].len == 0 && (ready <= 0 || !FD_ISSET(p_rd[i], &rfds))) continue;
 
                 unsigned char dir;              // jugador envia 1 byte con la direccion
-                ssize_t r = read(p_rd[i], &dir, 1);
+                uint64_t t_read = trace_begin();
+                ssize_t r = read_move(p_rd[i], i, &dir);
                 if (r == 1) {
+                    if (perf_on) perf.moves++;
+                    pending_move[i] = false;
+                    deadline_ns[i] = 0;
+                    stats_move_read(ls, i);
                     bool moved = false;
-                    if (dir <= 7) {
-                        int W = st->width, H = st->height;
-                        int nx = px[i] + DX[dir];
-                        int ny = py[i] + DY[dir];
-
-                        if (in_bounds(nx, ny, W, H)) {
-                            int idx_new = idx_xy(nx, ny, W);
-                            int val = st->board[idx_new];
-
-                            if (val > 0) {
-                                // valid move: sumar reward y capturar celda como -i
-                                // seccion critica de escritor, actualiza estado compartido
-                                rw_writer_enter(sy);
-                                st->players[i].v_moves++;
-                                st->players[i].score += (unsigned int)val; // suma recompensa
-                                st->board[idx_new] = -i;  // capturada por i
-                                // update shm pos
-                                st->players[i].pos_x = (unsigned short)nx; // pos en shm
-                                st->players[i].pos_y = (unsigned short)ny;
-                                rw_writer_exit(sy);
-
-                                // estado local del master
-                                px[i] = nx;
-                                py[i] = ny;
-
-                                repaint(sy);              // imprime vista A/B
-                                last_valid_ms = now_ms(); // reinicia timeout
-                                moved = true;
-                            } else {
-                                // destino no libre
-                                rw_writer_enter(sy);
-                                st->players[i].inv_moves++;
-                                rw_writer_exit(sy);
-                                repaint(sy);
-                            }
+                    if (late_reply[i]) {
+                        // llego despues del plazo: ya se conto como invalida, se descarta
+                        late_reply[i] = false;
+                        trace_end(TR_MOVE_READ, t_read, i);
+                    } else {
+                        int W = st->width;
+                        int idx_new = -1;
+                        bool valid = check_move(st, px[i], py[i], dir, &idx_new);
+                        trace_end(TR_MOVE_READ, t_read, i);
+                        if (valid) {
+                            // valid move: sumar reward y capturar celda como -i
+                            // seccion critica de escritor, actualiza estado compartido
+                            state_lock(sy);
+                            engine_commit_move(st->board, W, &st->players[i], i, idx_new);
+                            if (lg) movelog_push(lg, idx_new, i, idx_new % W, idx_new / W); // publica la captura
+                            if (zob) zob->hash = zobrist_move(zob->hash, idx_xy(px[i], py[i], W), idx_new, i);
+                            state_unlock(sy);
+                            vboard_capture(idx_new % W, idx_new / W, i);
+
+                            // estado local del master
+                            px[i] = idx_new % W;
+                            py[i] = idx_new / W;
+
+                            repaint(sy);              // imprime vista A/B
+                            last_valid_ms = now_ms(); // reinicia timeout
+                            moved = true;
                         } else {
-                            // out of bounds
-                            rw_writer_enter(sy);
-                            st->players[i].inv_moves++;
-                            rw_writer_exit(sy);
+                            // direccion invalida, fuera del tablero o destino no libre
+                            state_lock(sy);
+                            engine_reject_move(&st->players[i]);
+                            state_unlock(sy);
                             repaint(sy);
                         }
-                    } else {
-                        // direccion invalida
-                        rw_writer_enter(sy);
-                        st->players[i].inv_moves++;
-                        rw_writer_exit(sy);
-                        repaint(sy);
                     }
 
                     processed[i] = true;               // se consumió su solicitud
@@ -277,47 +471,49 @@ static void run_round_robin(state_t *st, sync_t *sy,
 
                     // re-habilitar SOLO al jugador que ya fue procesado (1 token nuevo)
                     //sem_pos t(&sy->G[i]);
-                    if (has_valid_move(st, i)) { // tiene movimientos validos
-                        sem_post(&sy->G[i]);
+                    if (has_move(st, px[i], py[i])) { // tiene movimientos validos
+                        enable_player(sy, ls, i);
                     } else {
                         // no tiene movimientos validos: marcar bloqueado
-                        rw_writer_enter(sy);
+                        state_lock(sy);
                         st->players[i].blocked = true;
-                        rw_writer_exit(sy);
+                        state_unlock(sy);
                         repaint(sy);
 
-                        // cerraramos su pipe y lo deshabilitamos
-                        if (p_rd[i] >= 0) { close(p_rd[i]); p_rd[i] = -1; }
-                        active_fd[i] = false;
+                        // cerraramos su pipe (salvo en pool) y lo deshabilitamos
+                        drop_player(p_rd, active_fd, i);
                     }
 
                 } else if (r == 0) {
-                    // eof: jugador cerro -> marcar bloqueado
-                    rw_writer_enter(sy);
+                    // eof: jugador cerro -> marcar bloqueado. Si murio con E o D tomados los
+                    // demas lectores quedarian esperando: se limpia antes de seguir
+                    lockwatch_sweep(sy, lock_watch);
+                    state_lock(sy);
                     st->players[i].blocked = true;
-                    rw_writer_exit(sy);
+                    state_unlock(sy);
                     repaint(sy);
-                    active_fd[i] = false;
-                    if (p_rd[i] >= 0) { close(p_rd[i]); p_rd[i] = -1; }
+                    close_player(p_rd, active_fd, i);
                 } else {
                     if (errno == EINTR) continue;   // retry
-                    active_fd[i] = false;           // error de lectura
-                    if (p_rd[i] >= 0) { close(p_rd[i]); p_rd[i] = -1; }
+                    close_player(p_rd, active_fd, i); // error de lectura
                 }
             }
         }
 
+        // plazos vencidos de los que todavia no contestaron
+        phase(PH_BLOCKED);
+        if (move_deadline_ms > 0) expire_deadlines(st, sy, nplayers, p_rd, active_fd, misses);
+
         // jugadores habilitados que no se procesaron: si no hay libres adyacentes -> bloquearlos
         for (int i = 0; i < nplayers; ++i) {
             if (!active_fd[i]) continue;
             if (processed[i]) continue;
-            if (!any_free_adjacent(st, px[i], py[i])) {
-                rw_writer_enter(sy);
+            if (!has_move(st, px[i], py[i])) {
+                state_lock(sy);
                 st->players[i].blocked = true;
-                rw_writer_exit(sy);
+                state_unlock(sy);
                 repaint(sy);
-                active_fd[i] = false;
-                if (p_rd[i] >= 0) { close(p_rd[i]); p_rd[i] = -1; }
+                drop_player(p_rd, active_fd, i);
                 // if (pids[i] > 0) { kill(pids[i], SIGTERM); }  // Ahora si no deberia de matarlos, y el master espera
             }
         }
@@ -336,11 +532,11 @@ static void run_round_robin(state_t *st, sync_t *sy,
             for (int i = 0; i <nplayers; ++i) {
                 if(!active_fd[i]) continue; // cuenta solo jguadores aun en juego
                 active++;
-                if (!has_valid_move(st, i)){
+                if (!has_move(st, px[i], py[i])){
                     stuck++;
-                    rw_writer_enter(sy);
+                    state_lock(sy);
                     st->players[i].blocked = true;
-                    rw_writer_exit(sy);
+                    state_unlock(sy);
                     repaint(sy);
                 }
             }
@@ -348,7 +544,7 @@ static void run_round_robin(state_t *st, sync_t *sy,
         }
 
         // delay entre impresiones si hubo al menos 1 movimiento valido
-        if (any_valid_this_cycle && step_ms > 0) sleep_ms(step_ms);
+        if (any_valid_this_cycle && step_ms > 0) { phase(PH_WAIT); sleep_ms(step_ms); }
 
         // si no queda nadie activo, salir
         bool any = false;
@@ -356,14 +552,68 @@ static void run_round_robin(state_t *st, sync_t *sy,
         if (!any) break;
     }
 
+    if (ls){
+        ls->run_ns += now_ns() - t_start;
+        for (int i = 0; i < nplayers; ++i) ls->moves += st->players[i].v_moves + st->players[i].inv_moves;
+        ls->games++;
+    }
+    if (!last_game) return;
+
     // señal de fin de juego
-    rw_writer_enter(sy);
+    state_lock(sy);
     st->game_over = true;
-    rw_writer_exit(sy);
+    state_unlock(sy);
     for (int i = 0; i < nplayers; ++i) sem_post(&sy->G[i]); // liberar a todos
     repaint(sy);
 }
 
+// Entre partidas del pool: recupera el G[i] que el jugador no llego a tomar o descarta la
+// jugada que quedo en vuelo. Al volver todos los jugadores vivos estan esperando G[i]
+static void park_players(sync_t *sy, int nplayers, int p_rd[]){
+    for (int i = 0; i < nplayers; ++i){
+        deadline_ns[i] = 0;
+        late_reply[i] = false;
+        if (pending_move[i]){
+            pending_move[i] = false;
+            int rc;
+            while ((rc = sem_trywait(&sy->G[i])) != 0 && errno == EINTR) {}
+            if (rc != 0 && p_rd[i] >= 0 && moveq[i].len == 0){
+                // el jugador ya tomo G[i]: esperar su byte (1s) y tirarlo
+                fd_set rfds; FD_ZERO(&rfds); FD_SET(p_rd[i], &rfds);
+                struct timeval tv = { 1, 0 };
+                unsigned char dir;
+                int ready = select(p_rd[i] + 1, &rfds, NULL, NULL, &tv);
+                if (ready <= 0 || read_move(p_rd[i], i, &dir) != 1){
+                    fprintf(stderr, "master: jugador %d no respondio entre partidas, queda afuera\n", i);
+                    close(p_rd[i]); p_rd[i] = -1;
+                }
+            }
+        }
+        moveq[i].len = 0;                       // jugadas adelantadas de la partida que termino
+    }
+}
+
+// Prepara la partida siguiente del pool sobre las mismas shm: los procesos no se relanzan,
+// los jugadores resincronizan su copia al ver el game_id nuevo del log
+static void next_game(state_t *st, sync_t *sy, movelog_t *lg, int nplayers, unsigned seed,
+                      const int p_rd[], int px[], int py[]){
+    int W = st->width, H = st->height;
+    engine_distribute_positions(nplayers, W, H, px, py);
+    state_lock(sy);
+    for (int i = 0; i < nplayers; ++i){
+        st->players[i].score = 0u;
+        st->players[i].inv_moves = 0u;
+        st->players[i].v_moves = 0u;
+        st->players[i].blocked = (p_rd[i] < 0);   // el que se fue no vuelve
+    }
+    engine_fill_board(st->board, W, H, seed, 0);
+    engine_place_players(st->board, W, st->players, nplayers, px, py);
+    if (lg) movelog_reset(lg, getpid(), st->width, st->height);
+    if (zob) zob->hash = zobrist_full(st);
+    state_unlock(sy);
+    vboard_load(st);
+}
+
 // Resultados
 static const char* color_name_for_player(unsigned i){
     static const char *names[8] = {
@@ -374,8 +624,6 @@ static const char* color_name_for_player(unsigned i){
 
 static void print_results(const state_t *st){
     printf("\n=== Resultados ===\n");
-    int winner = -1;
-
     for (unsigned i = 0; i < st->num_players; ++i){
         const player_t *p = &st->players[i];
         const char *col = color_name_for_player(i);
@@ -386,21 +634,10 @@ static void print_results(const state_t *st){
                p->score,
                p->v_moves,
                p->inv_moves);
-
-        if (winner < 0){
-            winner = (int)i;
-        } else {
-            // Criterios de desempate, mas validos, menos invalidos, menor pid
-            const player_t *w = &st->players[winner];
-            if (p->score > w->score ||
-               (p->score == w->score && p->v_moves > w->v_moves) ||
-               (p->score == w->score && p->v_moves == w->v_moves && p->inv_moves < w->inv_moves) ||
-               (p->score == w->score && p->v_moves == w->v_moves && p->inv_moves == w->inv_moves && p->player_pid < w->player_pid)){
-                winner = (int)i;
-               }
-        }
+        if (move_deadline_ms > 0) printf("  plazos vencidos: %u\n", deadline_misses[i]);
     }
 
+    int winner = engine_winner(st->players, (int)st->num_players);
     if (winner >= 0){
         const player_t *w = &st->players[winner];
         const char *wcol = color_name_for_player((unsigned)winner);
@@ -420,15 +657,23 @@ int main(int argc, char **argv){
     int delay = 400;
     int timeout = 10;
     int seed = (int)time(NULL);
+    int games = 1;
     char *view_path = NULL;
+    const char *stats_path = NULL;
     char *players[MAX_PLAYERS];
     int nplayers = 0;
+    const char *sock_path = NULL;       // -u
+    int nexternal = 0;                  // -x
+    placement_t placement = {0};        // -c / -f
+    int host_games = 0;                 // -n
+    int host_workers = 1;               // -j
+    bool want_perf = false;             // -P
 
     for (int i = 0; i < MAX_PLAYERS; ++i) players[i] = NULL;
 
     // Parseo de opciones cortas
     int opt;
-    const char *optstr = "w:h:d:t:s:v:p:";
+    const char *optstr = "w:h:d:t:s:v:p:r:g:m:u:x:c:f:n:j:P";
     while ((opt = getopt(argc, argv, optstr)) != -1){
         switch (opt){
             case 'w': {
@@ -466,9 +711,62 @@ int main(int argc, char **argv){
                 seed = (int)v;
                 break;
             }
+            case 'g': {
+                char *end = NULL;
+                long v = strtol(optarg, &end, 10);
+                if (end && *end != '\0'){ usage(argv[0]); return 1; }
+                games = clamp((int)v, 1, 1000000);
+                break;
+            }
+            case 'm': {
+                char *end = NULL;
+                long v = strtol(optarg, &end, 10);
+                if (end && *end != '\0'){ usage(argv[0]); return 1; }
+                move_deadline_ms = clamp((int)v, 0, 600000);
+                break;
+            }
+            case 'u':
+                sock_path = optarg;
+                break;
+            case 'x': {
+                char *end = NULL;
+                long v = strtol(optarg, &end, 10);
+                if (end && *end != '\0'){ usage(argv[0]); return 1; }
+                nexternal = clamp((int)v, 0, MAX_PLAYERS);
+                break;
+            }
+            case 'c':
+                if (placement_parse(&placement, optarg) != 0){ usage(argv[0]); return 1; }
+                break;
+            case 'f': {
+                char *end = NULL;
+                long v = strtol(optarg, &end, 10);
+                if ((end && *end != '\0') || placement_set_fifo(&placement, (int)v) != 0){ usage(argv[0]); return 1; }
+                break;
+            }
+            case 'n': {
+                char *end = NULL;
+                long v = strtol(optarg, &end, 10);
+                if (end && *end != '\0'){ usage(argv[0]); return 1; }
+                host_games = clamp((int)v, 0, HOST_MAX_GAMES);
+                break;
+            }
+            case 'j': {
+                char *end = NULL;
+                long v = strtol(optarg, &end, 10);
+                if (end && *end != '\0'){ usage(argv[0]); return 1; }
+                host_workers = clamp((int)v, 1, HOST_MAX_WORKERS);
+                break;
+            }
+            case 'P':
+                want_perf = true;
+                break;
             case 'v':
                 view_path = optarg;
                 break;
+            case 'r':
+                stats_path = optarg;
+                break;
             case 'p':
                 if (nplayers < MAX_PLAYERS) players[nplayers++] = optarg;
                 while (optind < argc && argv[optind][0] != '-' && nplayers < MAX_PLAYERS){
@@ -481,15 +779,36 @@ int main(int argc, char **argv){
         }
     }
 
-    if (W == 0 || H == 0 || view_path == NULL || nplayers == 0){
+    if (W == 0 || H == 0 || nplayers + nexternal == 0 || nplayers + nexternal > MAX_PLAYERS ||
+        (nexternal > 0) != (sock_path != NULL)){
         usage(argv[0]);
         return 1;
     }
 
-    // Semilla y cantidad de jugadores
+    // Multipartida: cada partida con sus segmentos y sus jugadores, sin vista ni extras por partida
+    if (host_games > 0){
+        if (view_path || games > 1 || move_deadline_ms > 0 || nexternal > 0 || stats_path || placement_enabled(&placement)){
+            fprintf(stderr, "master: -n no admite -v, -g, -m, -u/-x, -r ni -c/-f\n");
+            return 1;
+        }
+        host_cfg_t hc = { W, H, host_games, host_workers, nplayers, players, timeout, (unsigned)seed };
+        return host_run(&hc) == 0 ? 0 : 1;
+    }
+
+    // Semilla y cantidad de jugadores: los externos ocupan los lugares despues de los de -p
     int step_ms = delay;
-    srand((unsigned)seed);
-    int nplayers_cfg = nplayers;
+    int nplayers_cfg = nplayers + nexternal;
+
+    // traza: los hijos heredan CHOMP_TRACE y vuelcan al salir; el master junta todo al final
+    trace_init("master");
+    trace_discard_stale();
+
+    // Ubicacion: el master primero, despues cada proceso en el orden en que se lanza
+    int place_slot = 0;
+    placement_apply(&placement, 0, place_slot++, "master");
+
+    vboard_on = (padboard_init(&vboard, W, H) == 0);
+    if (!vboard_on) perror("master: tablero con borde (se valida sobre la shm)");
 
     // Crear y mapear shm de estado, sync e inicializacion de semaforos
     bool existed_state=false, created_sync=false;
@@ -500,9 +819,22 @@ int main(int argc, char **argv){
     if (created_sync && ipc_init_sync_semaphores(sy) != 0){
         perror("sem_init"); ipc_unmap_sync(sy); ipc_unmap_state(st); return 1;
     }
+    // extensiones (log de movimientos, frames para espectadores, contadores del lock):
+    // opcionales, sin ellas los jugadores copian el tablero completo y no hay espectadores
+    ext_header_t *ext = ipc_create_and_map_ext(ext_layout, sizeof(ext_layout) / sizeof(ext_layout[0]));
+    if (!ext) perror("master: create ext (sin log, espectadores ni contadores)");
+    movelog_t *lg = ext_section(ext, EXT_SEC_LOG, sizeof(movelog_t));
+    frame = ext_section(ext, EXT_SEC_FRAME, sizeof(frame_t));
+    if (frame) frame_reset(frame, getpid());
+    lock_stats = ext_section(ext, EXT_SEC_STATS, sizeof(lockstats_t));
+    if (lock_stats){ lock_stats->master_pid = getpid(); lock_stats->started_ns = now_ns(); }
+    lock_watch = ext_section(ext, EXT_SEC_LOCKWATCH, sizeof(lockwatch_t));
+    if (lock_watch) lock_watch->master_pid = getpid();
+    zob = ext_section(ext, EXT_SEC_ZOBRIST, sizeof(zobrist_t));
+    if (zob) zob->master_pid = getpid();
 
     // Inicializacion del estado compartido con exclusion de escritores
-    rw_writer_enter(sy);
+    state_lock(sy);
     st->width = W; st->height = H;
     st->num_players = (unsigned int)nplayers_cfg;
     st->game_over = false;
@@ -514,36 +846,108 @@ int main(int argc, char **argv){
         st->players[i].player_pid = 0;
         st->players[i].name[0] = '\0';
     }
-    board_fill_random(st);
-    rw_writer_exit(sy);
+    engine_fill_board(st->board, W, H, (unsigned)seed, 0);   // hilos automaticos
+    if (lg) movelog_reset(lg, getpid(), W, H);
+    state_unlock(sy);
 
     // Lanzar vista y jugadores
-    pid_t pid_view = launch_view(view_path, W, H);
-    if (pid_view < 0){ perror("fork view"); ipc_unmap_sync(sy); ipc_unmap_state(st); return 1; }
+    view_on = (view_path != NULL);
+    spinwait_init(&spin_b);
+    pid_t pid_view = view_on ? launch_view(view_path, W, H, &placement, place_slot) : 0;
+    if (pid_view < 0){ perror("fork view"); ipc_unmap_ext(ext); ipc_unmap_sync(sy); ipc_unmap_state(st); return 1; }
+    if (pid_view > 0) place_slot++;
 
     int p_rd[MAX_PLAYERS];
     for (int i = 0; i < MAX_PLAYERS; ++i) p_rd[i] = -1;
     pid_t pids[MAX_PLAYERS]; memset(pids,0,sizeof(pids));
     
-    launch_players(nplayers_cfg, players, p_rd, pids, W, H);
+    launch_players(st, sy, nplayers, players, p_rd, pids, W, H, &placement, place_slot);
+    place_slot += nplayers;
 
     // Registrar pids/nombres en shm
-    rw_writer_enter(sy);
-    for (int i=0;i<nplayers_cfg;++i){
+    state_lock(sy);
+    for (int i=0;i<nplayers;++i){
         snprintf(st->players[i].name, NAME_LEN, "P%d", i);
         st->players[i].player_pid = pids[i];
     }
-    rw_writer_exit(sy);
+    state_unlock(sy);
+
+    // Jugadores externos: no son hijos, no se los espera con waitpid (pids[i] queda en 0).
+    // Un lugar que no se llena a tiempo queda bloqueado toda la corrida
+    if (nexternal > 0){
+        int lfd = gw_listen(sock_path);
+        if (lfd < 0) perror("master: socket");
+        int fails = 0;              // conexiones rechazadas (saludo invalido, etc.)
+        for (int i = nplayers; i < nplayers_cfg && lfd >= 0 && fails < GW_MAX_FAILS; ){
+            char name[NAME_LEN];
+            pid_t epid = 0;
+            int fd = gw_accept(lfd, i, W, H, GW_JOIN_TIMEOUT_MS, name, &epid);
+            if (fd < 0){
+                if (errno == ETIMEDOUT) break;
+                perror("master: registro de jugador externo");
+                fails++;            // el lugar sigue libre para el proximo
+                continue;
+            }
+            p_rd[i] = fd;
+            state_lock(sy);
+            snprintf(st->players[i].name, NAME_LEN, "%s", name[0] ? name : "ext");
+            st->players[i].player_pid = epid;
+            state_unlock(sy);
+            lockwatch_set_peer(lock_watch, i, epid);
+            // el pid viene de SO_PEERCRED; si es de otro usuario la ubicacion falla y se avisa
+            if (epid > 0) placement_apply(&placement, epid, place_slot++, st->players[i].name);
+            ++i;
+        }
+        if (lfd >= 0) close(lfd);
+        unlink(sock_path);
+        state_lock(sy);
+        for (int i = nplayers; i < nplayers_cfg; ++i){
+            if (p_rd[i] >= 0) continue;
+            fprintf(stderr, "master: el lugar %d no se lleno, queda bloqueado\n", i);
+            st->players[i].blocked = true;
+        }
+        state_unlock(sy);
+    }
 
     // Posiciones iniciales y pintar
     int px[MAX_PLAYERS], py[MAX_PLAYERS];
-    distribute_positions(nplayers_cfg, (int)W, (int)H, px, py);
-    rw_writer_enter(sy); paint_initial_positions(st, nplayers_cfg, px, py); rw_writer_exit(sy);
+    engine_distribute_positions(nplayers_cfg, (int)W, (int)H, px, py);
+    state_lock(sy);
+    engine_place_players(st->board, W, st->players, nplayers_cfg, px, py);
+    if (zob) zob->hash = zobrist_full(st);
+    state_unlock(sy);
+    vboard_load(st);
 
     repaint(sy);
 
+    // contadores solo mientras corre el bucle de cada partida: el arranque, la preparacion
+    // entre partidas del pool y el cierre (waitpid, traza) no entran en ninguna fase
+    if (want_perf){
+        perf_on = (perfphase_open(&perf) == 0);
+        if (!perf_on) perror("master: perf_event_open (sin contadores por fase)");
+        else perfphase_pause(&perf);
+    }
+
     // Loop principal: atenciones round-robin hasta timeout o sin jugadores
-    run_round_robin(st, sy, nplayers_cfg, step_ms, timeout, px, py, p_rd, pids);
+    load_stats_t stats; memset(&stats, 0, sizeof(stats));
+    load_stats_t *ls = stats_path ? &stats : NULL;
+    pool_mode = (games > 1);
+    unsigned wins[MAX_PLAYERS] = {0};
+    uint64_t setup_ns = 0;              // preparacion entre partidas del pool
+    for (int g = 0; g < games; ++g){
+        if (g > 0){
+            uint64_t t0 = now_ns();
+            park_players(sy, nplayers_cfg, p_rd);
+            next_game(st, sy, lg, nplayers_cfg, (unsigned)seed + (unsigned)g, p_rd, px, py);
+            setup_ns += now_ns() - t0;
+            repaint(sy);
+        }
+        if (perf_on) perfphase_resume(&perf, PH_WAIT);
+        run_round_robin(st, sy, lg, nplayers_cfg, step_ms, timeout, px, py, p_rd, pids, ls, g == games - 1);
+        if (perf_on) perfphase_pause(&perf);
+        int w = engine_winner(st->players, nplayers_cfg);
+        if (w >= 0) wins[w]++;
+    }
 
     // Cierre de pipes de jugadores y espera de todos los hijos
     for (int i = 0; i < nplayers_cfg; ++i) {
@@ -553,12 +957,37 @@ int main(int argc, char **argv){
     for (int i = 0; i < nplayers_cfg; ++i) {
         if (pids[i] > 0) { int stc = 0; waitpid(pids[i], &stc, 0); }
     }
+    // RUSAGE_CHILDREN acumula hijos esperados: primero solo jugadores, despues jugadores + vista
+    struct rusage ru_players, ru_all, ru_self;
+    getrusage(RUSAGE_CHILDREN, &ru_players);
 
     if (pid_view > 0) { int stv = 0; waitpid(pid_view, &stv, 0); }
+    getrusage(RUSAGE_CHILDREN, &ru_all);
+    trace_flush();
+    trace_merge();
+    getrusage(RUSAGE_SELF, &ru_self);
 
     // Reporte final y limpieza
     print_results(st);
+    if (perf_on){ perfphase_report(&perf); perfphase_close(&perf); }
+    if (games > 1){
+        printf("\n=== Pool: %d partidas, preparacion media entre partidas %.1f us ===\n",
+               games, (double)setup_ns / 1e3 / (double)(games - 1));
+        for (int i = 0; i < nplayers_cfg; ++i)
+            printf("Jugador P%d: %u victorias\n", i, wins[i]);
+    }
+    if (ls){
+        qsort(ls->lat_us, ls->n, sizeof(*ls->lat_us), cmp_u32);
+        printf("Latencia G[i]->jugada: p50=%uus p99=%uus p999=%uus (%zu muestras)\n",
+               percentile(ls, 0.50), percentile(ls, 0.99), percentile(ls, 0.999), ls->n);
+        write_stats_csv(stats_path, st, delay, ls, ru_secs(&ru_self),
+                        ru_secs(&ru_all) - ru_secs(&ru_players), ru_secs(&ru_players));
+        free(ls->lat_us);
+    }
 
+    spinwait_report(&spin_b, "master");
+    if (vboard_on) padboard_free(&vboard);
+    ipc_unmap_ext(ext);
     ipc_unmap_sync(sy);
     ipc_unmap_state(st);
     return 0;
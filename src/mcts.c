@@ -0,0 +1,456 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#define _POSIX_C_SOURCE 200809L
+#include "mcts.h"
+#include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MCTS_MAX_NODES   (1 << 18)     // nodos del arbol por busqueda
+#define MCTS_DEQ_CAP     1024          // tareas por cola (potencia de 2)
+#define MCTS_DEPTH       24            // jugadas propias por rollout
+#define MCTS_MAX_PATH    256           // profundidad maxima del arbol
+#define MCTS_SCALE       1000000ull    // recompensa en punto fijo
+#define MCTS_UCT_C       0.7
+
+// first: -1 sin expandir, -2 un hilo lo esta expandiendo, >=0 indice del primer hijo
+typedef struct {
+    _Atomic int                first;
+    int                        parent;
+    unsigned char              dir;
+    unsigned char              nchild;
+    _Atomic unsigned int       visits;  // incluye perdida virtual de rollouts en curso
+    _Atomic unsigned long long value;   // suma de recompensas * MCTS_SCALE
+} mnode_t;
+
+// Cola de tareas (Chase-Lev acotada): el dueño hace push/take por abajo, los demas roban por arriba
+typedef struct {
+    _Atomic long top;
+    _Atomic long bottom;
+    _Atomic int  buf[MCTS_DEQ_CAP];
+} mdeque_t;
+
+typedef struct {
+    mcts_t     *mc;
+    int         id;
+    pthread_t   th;
+    int        *board;                  // copia de trabajo del tablero raiz
+    int        *undo_idx;               // celdas tocadas en la iteracion actual
+    int        *undo_val;
+    int         undo_n;
+    uint64_t    rng;
+    mdeque_t    dq;
+    unsigned long long rollouts;        // acumulado de todas las busquedas
+} mworker_t;
+
+struct mcts {
+    int            nthreads;
+    int            width, height;
+    mworker_t     *workers;
+    mnode_t       *nodes;
+    _Atomic int    nnodes;
+    pthread_barrier_t start, done;
+    sem_t          go;                  // un post por hilo cuando ya estan todos (o aborted si no)
+    bool           running;             // hilos creados y barreras inicializadas
+    atomic_bool    quit;
+    atomic_bool    aborted;             // no se pudieron crear todos los hilos
+
+    // snapshot de la busqueda en curso (solo lectura para los hilos)
+    const mirror_t *root;
+    int             me;
+    uint64_t        deadline_ns;
+
+    // estadisticas
+    unsigned long long searches;
+    uint64_t           search_ns;       // tiempo de pared buscando
+};
+
+static uint64_t now_ns(void){
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_next(uint64_t *s){
+    // xorshift64*
+    uint64_t x = *s;
+    x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+    *s = x;
+    return (uint32_t)((x * 2685821657736338717ull) >> 32);
+}
+
+// deque
+static void dq_reset(mdeque_t *d){
+    atomic_store_explicit(&d->top, 0, memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, 0, memory_order_relaxed);
+}
+
+static bool dq_push(mdeque_t *d, int x){
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t >= MCTS_DEQ_CAP) return false;    // llena: el llamador lo ejecuta en linea
+    atomic_store_explicit(&d->buf[b & (MCTS_DEQ_CAP - 1)], x, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return true;
+}
+
+static bool dq_take(mdeque_t *d, int *x){
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long t = atomic_load_explicit(&d->top, memory_order_relaxed);
+    if (t > b) {    // vacia
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return false;
+    }
+    *x = atomic_load_explicit(&d->buf[b & (MCTS_DEQ_CAP - 1)], memory_order_relaxed);
+    if (t == b) {   // ultimo elemento: competir con los ladrones
+        bool won = atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                       memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+static bool dq_steal(mdeque_t *d, int *x){
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return false;
+    *x = atomic_load_explicit(&d->buf[t & (MCTS_DEQ_CAP - 1)], memory_order_relaxed);
+    return atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+               memory_order_seq_cst, memory_order_relaxed);
+}
+
+// tablero de trabajo: cambios con undo para volver a la raiz sin copiar W*H
+static int take_cell(mworker_t *w, int idx, int owner){
+    int v = w->board[idx];
+    w->undo_idx[w->undo_n] = idx;
+    w->undo_val[w->undo_n] = v;
+    w->undo_n++;
+    w->board[idx] = -owner;
+    return v;
+}
+
+static void undo_all(mworker_t *w){
+    while (w->undo_n > 0) {
+        w->undo_n--;
+        w->board[w->undo_idx[w->undo_n]] = w->undo_val[w->undo_n];
+    }
+}
+
+// direcciones con destino libre desde (x,y)
+static int free_dirs(const mworker_t *w, int x, int y, unsigned char out[8]){
+    int W = w->mc->width, H = w->mc->height, n = 0;
+    for (int d = 0; d < 8; ++d) {
+        int nx = x + DX[d], ny = y + DY[d];
+        if (in_bounds(nx, ny, W, H) && w->board[idx_xy(nx, ny, W)] > 0) out[n++] = (unsigned char)d;
+    }
+    return n;
+}
+
+// estado propio durante una iteracion
+typedef struct { int x, y, gain, plies; } mpos_t;
+
+static void apply_own(mworker_t *w, mpos_t *p, unsigned char d){
+    p->x += DX[d]; p->y += DY[d];
+    int v = take_cell(w, idx_xy(p->x, p->y, w->mc->width), w->mc->me);
+    if (v > 0) p->gain += v;
+    p->plies++;
+}
+
+// Rollout aleatorio: los rivales y el jugador alternan capturas al azar
+static double rollout(mworker_t *w, mpos_t *p){
+    const mcts_t *mc = w->mc;
+    const mirror_t *m = mc->root;
+    int ox[MAX_PLAYERS], oy[MAX_PLAYERS];
+    bool alive[MAX_PLAYERS];
+    for (unsigned i = 0; i < m->num_players; ++i) {
+        ox[i] = m->players[i].pos_x; oy[i] = m->players[i].pos_y;
+        alive[i] = !m->players[i].blocked && (int)i != mc->me;
+    }
+
+    unsigned char dirs[8];
+    int depth = 0;
+    for (; depth < MCTS_DEPTH; ++depth) {
+        for (unsigned i = 0; i < m->num_players; ++i) {
+            if (!alive[i]) continue;
+            int n = free_dirs(w, ox[i], oy[i], dirs);
+            if (n == 0) { alive[i] = false; continue; }
+            unsigned char d = dirs[rng_next(&w->rng) % (unsigned)n];
+            ox[i] += DX[d]; oy[i] += DY[d];
+            take_cell(w, idx_xy(ox[i], oy[i], mc->width), (int)i);
+        }
+        int n = free_dirs(w, p->x, p->y, dirs);
+        if (n == 0) break;          // bloqueado: el resto de las jugadas no suma
+        apply_own(w, p, dirs[rng_next(&w->rng) % (unsigned)n]);
+    }
+    // recompensa media por jugada sobre un horizonte fijo, en [0,1]
+    double r = (double)p->gain / (9.0 * (double)(p->plies - depth + MCTS_DEPTH));
+    return (r > 1.0) ? 1.0 : r;
+}
+
+static void backprop(mcts_t *mc, int node, double r){
+    unsigned long long v = (unsigned long long)(r * (double)MCTS_SCALE);
+    for (; node >= 0; node = mc->nodes[node].parent)
+        atomic_fetch_add_explicit(&mc->nodes[node].value, v, memory_order_relaxed);
+}
+
+static void root_pos(const mcts_t *mc, mpos_t *p){
+    const player_t *me = &mc->root->players[mc->me];
+    p->x = me->pos_x; p->y = me->pos_y; p->gain = 0; p->plies = 0;
+}
+
+// UCT sobre los hijos publicados de node
+static int select_child(mcts_t *mc, int node, int first){
+    mnode_t *nd = &mc->nodes[node];
+    double lnN = log((double)atomic_load_explicit(&nd->visits, memory_order_relaxed) + 1.0);
+    int best = first;
+    double best_u = -1.0;
+    for (int c = first; c < first + nd->nchild; ++c) {
+        unsigned int n = atomic_load_explicit(&mc->nodes[c].visits, memory_order_relaxed);
+        if (n == 0) return c;
+        double q = (double)atomic_load_explicit(&mc->nodes[c].value, memory_order_relaxed)
+                   / ((double)n * (double)MCTS_SCALE);
+        double u = q + MCTS_UCT_C * sqrt(lnN / (double)n);
+        if (u > best_u) { best_u = u; best = c; }
+    }
+    return best;
+}
+
+// Expande node si nadie lo hizo. Devuelve el primer hijo, -1 si es terminal o no se pudo
+static int expand(mworker_t *w, int node, const mpos_t *p){
+    mcts_t *mc = w->mc;
+    mnode_t *nd = &mc->nodes[node];
+    int expected = -1;
+    if (!atomic_compare_exchange_strong(&nd->first, &expected, -2)) return -1;
+
+    unsigned char dirs[8];
+    int n = free_dirs(w, p->x, p->y, dirs);
+    int base = (n > 0) ? atomic_fetch_add(&mc->nnodes, n) : -1;
+    if (n == 0 || base + n > MCTS_MAX_NODES) {
+        // terminal o sin memoria: queda como hoja para siempre
+        return -1;
+    }
+    for (int k = 0; k < n; ++k) {
+        mnode_t *c = &mc->nodes[base + k];
+        atomic_store_explicit(&c->first, -1, memory_order_relaxed);
+        c->parent = node;
+        c->dir = dirs[k];
+        c->nchild = 0;
+        atomic_store_explicit(&c->visits, 0, memory_order_relaxed);
+        atomic_store_explicit(&c->value, 0, memory_order_relaxed);
+    }
+    nd->nchild = (unsigned char)n;
+    atomic_store_explicit(&nd->first, base, memory_order_release);
+    return base;
+}
+
+// Tarea robable: rollout desde un nodo recien expandido (rehace el camino desde la raiz)
+static void run_task(mworker_t *w, int node){
+    mcts_t *mc = w->mc;
+    unsigned char path[MCTS_MAX_PATH];
+    int len = 0;
+    for (int n = node; n > 0 && len < MCTS_MAX_PATH; n = mc->nodes[n].parent) {
+        path[len++] = mc->nodes[n].dir;
+        atomic_fetch_add_explicit(&mc->nodes[n].visits, 1, memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&mc->nodes[0].visits, 1, memory_order_relaxed);
+
+    mpos_t p; root_pos(mc, &p);
+    while (len > 0) apply_own(w, &p, path[--len]);
+    backprop(mc, node, rollout(w, &p));
+    undo_all(w);
+    w->rollouts++;
+}
+
+// Iteracion completa: seleccion, expansion, rollout y propagacion
+static void iterate(mworker_t *w){
+    mcts_t *mc = w->mc;
+    mpos_t p; root_pos(mc, &p);
+    int node = 0;
+    atomic_fetch_add_explicit(&mc->nodes[0].visits, 1, memory_order_relaxed);
+
+    for (int depth = 0; depth < MCTS_MAX_PATH; ++depth) {
+        int first = atomic_load_explicit(&mc->nodes[node].first, memory_order_acquire);
+        if (first == -1) {
+            first = expand(w, node, &p);
+            if (first >= 0) {
+                // los demas hijos quedan como tareas para este hilo o para quien las robe
+                for (int c = first + 1; c < first + mc->nodes[node].nchild; ++c)
+                    if (!dq_push(&w->dq, c)) break;
+                node = first;
+                atomic_fetch_add_explicit(&mc->nodes[node].visits, 1, memory_order_relaxed);
+                apply_own(w, &p, mc->nodes[node].dir);
+            }
+            break;
+        }
+        if (first < 0) break;       // otro hilo lo esta expandiendo: rollout desde aca
+        node = select_child(mc, node, first);
+        atomic_fetch_add_explicit(&mc->nodes[node].visits, 1, memory_order_relaxed);
+        apply_own(w, &p, mc->nodes[node].dir);
+    }
+    backprop(mc, node, rollout(w, &p));
+    undo_all(w);
+    w->rollouts++;
+}
+
+static bool steal_any(mworker_t *w, int *task){
+    mcts_t *mc = w->mc;
+    for (int k = 1; k < mc->nthreads; ++k) {
+        mworker_t *v = &mc->workers[(w->id + k) % mc->nthreads];
+        if (dq_steal(&v->dq, task)) return true;
+    }
+    return false;
+}
+
+static void work(mworker_t *w){
+    mcts_t *mc = w->mc;
+    memcpy(w->board, mc->root->board, (size_t)mc->width * (size_t)mc->height * sizeof(int));
+    while (now_ns() < mc->deadline_ns) {
+        int task;
+        if (dq_take(&w->dq, &task) || steal_any(w, &task)) run_task(w, task);
+        else iterate(w);
+    }
+}
+
+static void *worker_main(void *arg){
+    mworker_t *w = arg;
+    // las barreras son de nthreads: hasta que no esten todos creados no se entra
+    while (sem_wait(&w->mc->go) != 0) {}
+    if (atomic_load(&w->mc->aborted)) return NULL;
+    while (1) {
+        pthread_barrier_wait(&w->mc->start);
+        if (atomic_load(&w->mc->quit)) break;
+        work(w);
+        pthread_barrier_wait(&w->mc->done);
+    }
+    return NULL;
+}
+
+mcts_t* mcts_create(int nthreads, unsigned short w, unsigned short h){
+    if (nthreads < 1) nthreads = 1;
+    mcts_t *mc = calloc(1, sizeof(*mc));
+    if (!mc) return NULL;
+    mc->nthreads = nthreads;
+    mc->width = w; mc->height = h;
+    mc->nodes = malloc(sizeof(mnode_t) * MCTS_MAX_NODES);
+    mc->workers = calloc((size_t)nthreads, sizeof(mworker_t));
+    if (!mc->nodes || !mc->workers) { free(mc->nodes); free(mc->workers); free(mc); return NULL; }
+    atomic_init(&mc->quit, false);
+    atomic_init(&mc->aborted, false);
+
+    size_t cells = (size_t)w * (size_t)h;
+    size_t undo = (size_t)(MCTS_MAX_PATH + MCTS_DEPTH * MAX_PLAYERS);
+    for (int i = 0; i < nthreads; ++i) {
+        mworker_t *wk = &mc->workers[i];
+        wk->mc = mc; wk->id = i;
+        wk->board = malloc(cells * sizeof(int));
+        wk->undo_idx = malloc(undo * sizeof(int));
+        wk->undo_val = malloc(undo * sizeof(int));
+        wk->rng = (uint64_t)0x9E3779B97F4A7C15ull ^ ((uint64_t)(i + 1) * (uint64_t)0xBF58476D1CE4E5B9ull) ^ now_ns();
+        if (!wk->board || !wk->undo_idx || !wk->undo_val) { mcts_destroy(mc); return NULL; }
+    }
+
+    if (sem_init(&mc->go, 0, 0) != 0) { mcts_destroy(mc); return NULL; }
+    pthread_barrier_init(&mc->start, NULL, (unsigned)nthreads);
+    pthread_barrier_init(&mc->done, NULL, (unsigned)nthreads);
+    int created = 1;
+    while (created < nthreads) {
+        int rc = pthread_create(&mc->workers[created].th, NULL, worker_main, &mc->workers[created]);
+        if (rc != 0) { fprintf(stderr, "mcts: pthread_create: %s\n", strerror(rc)); break; }
+        created++;
+    }
+    // si falto alguno, los que arrancaron salen sin tocar las barreras
+    if (created < nthreads) atomic_store(&mc->aborted, true);
+    for (int i = 1; i < created; ++i) sem_post(&mc->go);
+    if (created < nthreads) {
+        for (int i = 1; i < created; ++i) pthread_join(mc->workers[i].th, NULL);
+        pthread_barrier_destroy(&mc->start);
+        pthread_barrier_destroy(&mc->done);
+        sem_destroy(&mc->go);
+        mcts_destroy(mc);
+        return NULL;
+    }
+    mc->running = true;
+    return mc;
+}
+
+int mcts_search(mcts_t *mc, const mirror_t *m, int me, uint64_t deadline_ns){
+    uint64_t t0 = now_ns();
+    mc->root = m;
+    mc->me = me;
+    mc->deadline_ns = deadline_ns;
+
+    // raiz nueva en cada turno
+    atomic_store(&mc->nnodes, 1);
+    mnode_t *r = &mc->nodes[0];
+    atomic_store(&r->first, -1);
+    r->parent = -1; r->dir = 0; r->nchild = 0;
+    atomic_store(&r->visits, 0);
+    atomic_store(&r->value, 0);
+    for (int i = 0; i < mc->nthreads; ++i) dq_reset(&mc->workers[i].dq);
+
+    // el hilo que llama trabaja como hilo 0
+    pthread_barrier_wait(&mc->start);
+    work(&mc->workers[0]);
+    pthread_barrier_wait(&mc->done);
+
+    mc->searches++;
+    mc->search_ns += now_ns() - t0;
+
+    // la jugada mas visitada
+    int first = atomic_load(&r->first);
+    if (first < 0) return -1;
+    int best = first;
+    for (int c = first; c < first + r->nchild; ++c)
+        if (atomic_load(&mc->nodes[c].visits) > atomic_load(&mc->nodes[best].visits)) best = c;
+    return mc->nodes[best].dir;
+}
+
+void mcts_report(const mcts_t *mc, int me){
+    unsigned long long total = 0;
+    char per[512];              // rollouts de cada hilo (con robo de trabajo no son parejos)
+    size_t len = 0;
+    per[0] = '\0';
+    for (int i = 0; i < mc->nthreads; ++i) {
+        total += mc->workers[i].rollouts;
+        if (len < sizeof(per)) {
+            int n = snprintf(per + len, sizeof(per) - len, "%s%llu", i ? "/" : "", mc->workers[i].rollouts);
+            if (n > 0) len += (size_t)n;
+        }
+    }
+    double secs = (double)mc->search_ns / 1e9;
+    double rate = (secs > 0) ? (double)total / secs : 0.0;
+    fprintf(stderr, "player %d: mcts hilos=%d busquedas=%llu rollouts=%llu rollouts/s=%.0f por hilo=%s\n",
+            me, mc->nthreads, mc->searches, total, rate, per);
+}
+
+void mcts_destroy(mcts_t *mc){
+    if (!mc) return;
+    if (mc->running) {
+        atomic_store(&mc->quit, true);
+        pthread_barrier_wait(&mc->start);
+        for (int i = 1; i < mc->nthreads; ++i) pthread_join(mc->workers[i].th, NULL);
+        pthread_barrier_destroy(&mc->start);
+        pthread_barrier_destroy(&mc->done);
+        sem_destroy(&mc->go);
+    }
+    for (int i = 0; i < mc->nthreads; ++i) {
+        free(mc->workers[i].board);
+        free(mc->workers[i].undo_idx);
+        free(mc->workers[i].undo_val);
+    }
+    free(mc->workers);
+    free(mc->nodes);
+    free(mc);
+}
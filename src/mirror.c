@@ -0,0 +1,60 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "mirror.h"
+#include <stdlib.h>
+#include <string.h>
+
+int mirror_init(mirror_t *m, unsigned short w, unsigned short h){
+    memset(m, 0, sizeof(*m));
+    m->width = w;
+    m->height = h;
+    m->board = malloc((size_t)w * (size_t)h * sizeof(int));
+    return m->board ? 0 : -1;
+}
+
+// copia completa del tablero, caso inicial o cuando el log ya no alcanza
+static void full_sync(mirror_t *m, const state_t *st, const movelog_t *lg){
+    memcpy(m->board, st->board, (size_t)m->width * (size_t)m->height * sizeof(int));
+    if (lg) {
+        m->game_id = lg->game_id;
+        m->seq = lg->head;
+    }
+    m->valid = true;
+    m->full_syncs++;
+}
+
+void mirror_sync(mirror_t *m, const state_t *st, const movelog_t *lg){
+    // la tabla de jugadores es chica, se copia siempre
+    m->num_players = st->num_players;
+    if (m->num_players > MAX_PLAYERS) m->num_players = MAX_PLAYERS;
+    memcpy(m->players, st->players, sizeof(m->players));
+
+    // sin log o con un log que no corresponde a este tablero: copia completa
+    if (!lg || lg->width != m->width || lg->height != m->height) {
+        full_sync(m, st, NULL);
+        return;
+    }
+
+    // partida nueva, primera lectura, o se perdieron registros (el anillo dio la vuelta)
+    unsigned long long head = lg->head;
+    if (!m->valid || m->game_id != lg->game_id || head < m->seq || head - m->seq > MOVELOG_CAP) {
+        full_sync(m, st, lg);
+        return;
+    }
+
+    // aplicar solo los registros nuevos
+    unsigned int cells = (unsigned int)m->width * (unsigned int)m->height;
+    for (; m->seq < head; m->seq++) {
+        const move_rec_t *r = &lg->recs[m->seq & (MOVELOG_CAP - 1)];
+        if (r->idx < cells) m->board[r->idx] = -(int)r->owner;
+        m->applied++;
+    }
+}
+
+void mirror_free(mirror_t *m){
+    free(m->board);
+    m->board = NULL;
+    m->valid = false;
+}
@@ -0,0 +1,40 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "padboard.h"
+#include <stdlib.h>
+#include <string.h>
+
+int padboard_init(padboard_t *b, int W, int H){
+    memset(b, 0, sizeof(*b));
+    b->width = W; b->height = H;
+    b->stride = W + 2;
+    size_t n = (size_t)(W + 2) * (size_t)(H + 2);
+    b->mem = malloc(n * sizeof(int));
+    if (!b->mem) return -1;
+    b->cells = b->mem + b->stride + 1;
+    for (int d = 0; d < 8; ++d) b->nb[d] = DY[d] * b->stride + DX[d];
+
+    // borde: primera y ultima fila completas, y la columna de cada lado
+    for (int x = 0; x < b->stride; ++x){
+        b->mem[x] = PAD_WALL;
+        b->mem[(size_t)(H + 1) * (size_t)b->stride + (size_t)x] = PAD_WALL;
+    }
+    for (int y = 0; y < H; ++y){
+        b->cells[padboard_idx(b, -1, y)] = PAD_WALL;
+        b->cells[padboard_idx(b, W, y)] = PAD_WALL;
+    }
+    return 0;
+}
+
+void padboard_load(padboard_t *b, const int *flat){
+    for (int y = 0; y < b->height; ++y)
+        memcpy(b->cells + padboard_idx(b, 0, y), flat + (size_t)y * (size_t)b->width,
+               (size_t)b->width * sizeof(int));
+}
+
+void padboard_free(padboard_t *b){
+    free(b->mem);
+    b->mem = b->cells = NULL;
+}
@@ -0,0 +1,151 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#define _GNU_SOURCE             // syscall(SYS_perf_event_open)
+#include "perfphase.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+static const struct { uint32_t type; uint64_t config; const char *name; } counters[PC_COUNT] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,       "ciclos"        },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,     "instrucciones" },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,     "cache misses"  },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES,    "branch misses" },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, "cambios ctx"   },
+};
+
+static const char *phase_names[PH_COUNT] = {
+    "espera", "validacion", "escritor", "repaint", "bloqueos",
+};
+
+#define READ_FMT (PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING)
+
+// Lectura del grupo: nr, tiempo habilitado, tiempo en la PMU y un valor por contador
+typedef struct { uint64_t nr, enabled, running, values[PC_COUNT]; } group_read_t;
+
+static int open_counter(int c, int group){
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = counters[c].type;
+    attr.config = counters[c].config;
+    attr.disabled = (group < 0);        // el lider arranca parado y habilita a todo el grupo
+    attr.exclude_hv = 1;
+    attr.read_format = READ_FMT;
+    int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+    if (fd < 0 && (errno == EACCES || errno == EPERM)){
+        // con perf_event_paranoid >= 2 solo se puede contar el espacio de usuario
+        attr.exclude_kernel = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+    }
+    return fd;
+}
+
+static bool read_group(perfphase_t *pp, group_read_t *g){
+    ssize_t r = read(pp->leader, g, sizeof(*g));
+    if (r < (ssize_t)(3 * sizeof(uint64_t))) return false;
+    if (g->running < g->enabled) pp->multiplexed = true;
+    return true;
+}
+
+int perfphase_open(perfphase_t *pp){
+    memset(pp, 0, sizeof(*pp));
+    pp->leader = -1;
+    int err = 0;
+    for (int c = 0; c < PC_COUNT; ++c){
+        pp->fd[c] = open_counter(c, pp->leader);
+        if (pp->fd[c] < 0){ err = errno; continue; }
+        if (pp->leader < 0) pp->leader = pp->fd[c];
+        pp->slot[c] = pp->nopen++;
+    }
+    if (pp->leader < 0){ errno = err; return -1; }
+
+    ioctl(pp->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(pp->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    group_read_t g;
+    if (read_group(pp, &g)){
+        for (int c = 0; c < PC_COUNT; ++c)
+            if (pp->fd[c] >= 0) pp->last[c] = g.values[pp->slot[c]];
+    }
+    pp->cur = PH_WAIT;
+    return 0;
+}
+
+// Suma a la fase actual lo contado desde la ultima lectura
+static void account(perfphase_t *pp){
+    group_read_t g;
+    if (!read_group(pp, &g)) return;
+    for (int c = 0; c < PC_COUNT; ++c){
+        if (pp->fd[c] < 0) continue;
+        uint64_t v = g.values[pp->slot[c]];
+        pp->total[pp->cur][c] += v - pp->last[c];
+        pp->last[c] = v;
+    }
+}
+
+phase_t perfphase_switch(perfphase_t *pp, phase_t ph){
+    phase_t prev = pp->cur;
+    if (pp->leader < 0 || prev == ph) return prev;
+    account(pp);
+    pp->cur = ph;
+    return prev;
+}
+
+void perfphase_pause(perfphase_t *pp){
+    if (pp->leader < 0 || pp->paused) return;
+    account(pp);
+    ioctl(pp->leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    pp->paused = true;
+}
+
+void perfphase_resume(perfphase_t *pp, phase_t ph){
+    if (pp->leader < 0 || !pp->paused) return;
+    ioctl(pp->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    // parados no cuentan, pero se relee igual: lo de la pausa no es de ninguna fase
+    group_read_t g;
+    if (read_group(pp, &g)){
+        for (int c = 0; c < PC_COUNT; ++c)
+            if (pp->fd[c] >= 0) pp->last[c] = g.values[pp->slot[c]];
+    }
+    pp->cur = ph;
+    pp->paused = false;
+}
+
+static void print_row(const perfphase_t *pp, const char *name, const uint64_t *v, uint64_t per){
+    printf("%-12s", name);
+    for (int c = 0; c < PC_COUNT; ++c){
+        if (pp->fd[c] < 0) printf(" %15s", "n/d");
+        else if (per > 0) printf(" %15.1f", (double)v[c] / (double)per);
+        else printf(" %15llu", (unsigned long long)v[c]);
+    }
+    if (pp->fd[PC_CYCLES] >= 0 && pp->fd[PC_INSTR] >= 0 && v[PC_CYCLES] > 0)
+        printf(" %6.2f", (double)v[PC_INSTR] / (double)v[PC_CYCLES]);
+    putchar('\n');
+}
+
+void perfphase_report(perfphase_t *pp){
+    if (pp->leader < 0) return;
+    if (!pp->paused) account(pp);       // cierra la fase en curso
+    printf("\n=== Contadores por fase (perf_event_open, %llu jugadas) ===\n", (unsigned long long)pp->moves);
+    printf("%-12s", "fase");
+    for (int c = 0; c < PC_COUNT; ++c) printf(" %15s", counters[c].name);
+    printf(" %6s\n", "IPC");
+    for (int p = 0; p < PH_COUNT; ++p) print_row(pp, phase_names[p], pp->total[p], 0);
+    if (pp->moves > 0){
+        printf("por jugada:\n");
+        for (int p = 0; p < PH_COUNT; ++p) print_row(pp, phase_names[p], pp->total[p], pp->moves);
+    }
+    if (pp->multiplexed) printf("(contadores multiplexados: el kernel no los tuvo todos en la PMU todo el tiempo)\n");
+}
+
+void perfphase_close(perfphase_t *pp){
+    for (int c = 0; c < PC_COUNT; ++c)
+        if (pp->fd[c] >= 0) close(pp->fd[c]);
+    pp->leader = -1;
+}
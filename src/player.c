@@ -11,22 +11,65 @@
 #include <errno.h>
 #include <string.h>
 #include <getopt.h>
+#include <stdint.h>
+#include <signal.h>
 #include "ipc.h"
 #include "rwsem.h"
+#include "mirror.h"
+#include "mcts.h"
+#include "strategy.h"
+#include "gateway.h"
+#include "spinwait.h"
+#include "trace.h"
+
+// Elige al azar entre las direcciones cuyo destino esta libre en la copia local.
+// Si no hay ninguna devuelve una cualquiera (el master la contara como invalida)
+static unsigned char choose_dir(const mirror_t *m, int me, unsigned *seed){
+    const player_t *p = &m->players[me];
+    int x = (int)p->pos_x, y = (int)p->pos_y;
+    unsigned char free_dirs[8];
+    int n = 0;
+    for (int d = 0; d < 8; ++d){
+        int nx = x + DX[d], ny = y + DY[d];
+        if (!in_bounds(nx, ny, m->width, m->height)) continue;
+        if (m->board[idx_xy(nx, ny, m->width)] > 0) free_dirs[n++] = (unsigned char)d;
+    }
+    if (n == 0) return (unsigned char)(rand_r(seed) % 8);
+    return free_dirs[(unsigned)rand_r(seed) % (unsigned)n];
+}
+
+static uint64_t now_ns(void){
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
 
 static void usage(const char *p){
-    fprintf(stderr, "Uso: %s [-i idx] [-w ancho -h alto]  o  %s [-i idx] ancho alto\n", p, p);
+    fprintf(stderr, "Uso: %s [-i idx] [-S estrategia.so | -T hilos] [-b budget_ms] [-w ancho -h alto]  o  %s [opciones] ancho alto\n", p, p);
+    fprintf(stderr, "     %s -u socket [-n nombre] [opciones]   (jugador externo, ver master -u/-x)\n", p);
+    fprintf(stderr, "  -S so      estrategia cargada con dlopen (ver include/strategy.h)\n");
+    fprintf(stderr, "  -T hilos   busqueda MCTS con ese numero de hilos (0 = movimiento aleatorio)\n");
+    fprintf(stderr, "  -b ms      tiempo por jugada, medido desde que llega G[i] (default 20)\n");
 }
 
 int main(int argc, char **argv){
     int me = -1;                    // indice del jugador dentro de st->players[]
     unsigned short W = 0, H = 0;
+    int threads = 0;                // hilos de MCTS, 0 = sin busqueda
+    int budget_ms = 20;             // tiempo de busqueda por jugada
+    const char *strategy_path = NULL;
+    const char *sock_path = NULL;   // -u: conectarse al master por socket en vez de ser su hijo
+    const char *name = "ext";
 
     // Parseo de parametros y fallback posicional
     int opt;
-    while ((opt = getopt(argc, argv, "i:w:h:")) != -1){
+    while ((opt = getopt(argc, argv, "i:w:h:T:b:S:u:n:")) != -1){
         switch(opt){
             case 'i': me = (int)strtol(optarg, NULL, 10); break;
+            case 'T': threads = (int)strtol(optarg, NULL, 10); break;
+            case 'b': budget_ms = (int)strtol(optarg, NULL, 10); break;
+            case 'S': strategy_path = optarg; break;
+            case 'u': sock_path = optarg; break;
+            case 'n': name = optarg; break;
             case 'w': W  = (unsigned short)strtoul(optarg, NULL, 10); break;
             case 'h': H  = (unsigned short)strtoul(optarg, NULL, 10); break;
             default: usage(argv[0]); return 2;
@@ -37,13 +80,36 @@ int main(int argc, char **argv){
         W = (unsigned short)strtoul(argv[optind],     NULL, 10);
         H = (unsigned short)strtoul(argv[optind + 1], NULL, 10);
     }
-    if (W == 0 || H == 0){ usage(argv[0]); return 2; }
+    if (!sock_path && (W == 0 || H == 0)){ usage(argv[0]); return 2; }
 
-    // Conexion con las 2 shm
-    state_t *st = ipc_open_and_map_state();
-    if (!st){ perror("player: open state"); return 1; }
-    sync_t  *sy = ipc_open_and_map_sync();
-    if (!sy){ perror("player: open sync"); ipc_unmap_state(st); return 1; }
+    // Conexion con las 2 shm: por nombre o con los fds que manda el master por el socket
+    state_t *st = NULL;
+    sync_t  *sy = NULL;
+    ext_header_t *ext = NULL;
+    pid_t master = getppid();
+    int out_fd = STDOUT_FILENO;     // a donde van las direcciones
+    if (sock_path){
+        gw_welcome_t wl;
+        int fds[GW_NFDS];
+        out_fd = gw_join(sock_path, name, &wl, fds);
+        if (out_fd < 0){ perror("player: socket"); return 1; }
+        st = ipc_map_state_fd(fds[0], false);
+        sy = ipc_map_sync_fd(fds[1]);
+        ext = (fds[2] >= 0) ? ipc_map_ext_fd(fds[2], true) : NULL;
+        if (!st || !sy){
+            perror("player: map fds");
+            ipc_unmap_ext(ext); ipc_unmap_sync(sy); ipc_unmap_state(st); close(out_fd);
+            return 1;
+        }
+        me = wl.index;
+        master = (pid_t)wl.master_pid;
+        W = wl.width; H = wl.height;
+    } else {
+        st = ipc_open_and_map_state();
+        if (!st){ perror("player: open state"); return 1; }
+        sy = ipc_open_and_map_sync();
+        if (!sy){ perror("player: open sync"); ipc_unmap_state(st); return 1; }
+    }
 
     // Advertencia si W/H locales difieren de los de la shm
     if (st->width != W || st->height != H){
@@ -65,35 +131,111 @@ int main(int argc, char **argv){
         }
         if (found < 0) {
             fprintf(stderr, "player: no pude resolver mi índice por PID\n");
-            ipc_unmap_sync(sy); ipc_unmap_state(st);
+            ipc_unmap_ext(ext); ipc_unmap_sync(sy); ipc_unmap_state(st);
             return 2;
         }
         me = found;
     }
 
+    // Traza (CHOMP_TRACE): sin SIGPIPE, una escritura al pipe cerrado sale por EPIPE y el
+    // buffer se vuelca al terminar
+    char trace_name[32];
+    snprintf(trace_name, sizeof(trace_name), "jugador %d", me);
+    trace_init(trace_name);
+    if (trace_enabled) signal(SIGPIPE, SIG_IGN);
+
+    // Copia local del tablero y log de movimientos (si el master lo publica)
+    mirror_t mirror;
+    if (mirror_init(&mirror, st->width, st->height) != 0){
+        perror("player: mirror");
+        ipc_unmap_ext(ext); ipc_unmap_sync(sy); ipc_unmap_state(st);
+        return 1;
+    }
+    if (!sock_path) ext = ipc_open_and_map_ext(true);
+    const movelog_t *lg = ext_section(ext, EXT_SEC_LOG, sizeof(movelog_t));
+    const zobrist_t *zob = ext_section(ext, EXT_SEC_ZOBRIST, sizeof(zobrist_t));
+    if (zob && zob->master_pid != master) zob = NULL;
+    unsigned long long hash = 0;    // Zobrist del estado de la copia (clave para la estrategia)
+    // anotarse como lector para que el master pueda limpiar si este proceso muere con el lock
+    // (por el gateway con el indice: el master lo verifica con el pid de SO_PEERCRED)
+    lockwatch_t *lw = ext_section(ext, EXT_SEC_LOCKWATCH, sizeof(lockwatch_t));
+    if (lw && lw->master_pid == master && lockwatch_attach(lw, sock_path ? me : -1) < 0)
+        fprintf(stderr, "player: sin lugar en el lockwatch, sigo sin vigilancia\n");
+
+    // Estrategia externa: tiene prioridad sobre MCTS y el movimiento aleatorio
+    strategy_t strat = {0};
+    bool use_strat = false;
+    if (strategy_path){
+        if (strategy_load(&strat, strategy_path) == 0 &&
+            strat.init(st->width, st->height, me, &strat.ctx) == 0){
+            use_strat = true;
+        } else {
+            fprintf(stderr, "player: estrategia %s no disponible, sigo con la interna\n", strategy_path);
+            if (strat.handle){ strat.shutdown = NULL; strategy_unload(&strat); }
+        }
+    }
+
+    // Pool de busqueda, se crea una vez y se reusa en cada turno
+    mcts_t *mc = NULL;
+    if (threads > 0 && !use_strat){
+        mc = mcts_create(threads, st->width, st->height);
+        if (!mc) fprintf(stderr, "player: no pude crear MCTS, sigo con movimientos aleatorios\n");
+    }
+
     // Semilla propia para movimientos aleatorios
     unsigned seed = (unsigned)time(NULL) ^ ((unsigned)getpid()<<16) ^ (unsigned)me;
 
+    // Espera de G[me]: gira un poco antes de dormir si CHOMP_SPIN lo pide
+    spinwait_t spin;
+    spinwait_init(&spin);
+
     // Loop principal
     // Protocolo con el master:
     // 1. Esperar habilitacion en G[me] (sem_wait)
-    // 2. Leer estado con lock de lector y ver si game_over
-    // 3. Elegir direccion y escribir 1 byte a stdout (pipe del master)
+    // 2. Con lock de lector: ver si game_over y actualizar la copia local
+    //    (solo los movimientos nuevos si hay log, el tablero entero si no)
+    // 3. Elegir direccion sobre la copia y escribir 1 byte a stdout (pipe del master)
     while (1){
         // Esperar permiso del master para enviar una solicitud
-        if (sem_wait(&sy->G[me]) != 0){
+        uint64_t t_wait = trace_begin();
+        if (spinwait_sem(&spin, &sy->G[me]) != 0){
             if (errno == EINTR) continue;
             break;
         }
+        trace_end(TR_PLAYER_WAIT, t_wait, me);
+        uint64_t t0 = now_ns();         // el presupuesto de busqueda corre desde aca
+        uint64_t t_sync = trace_begin();
         // Leer estado con exclusion de lectores
         rw_reader_enter(sy);
         bool over = st->game_over;
+        if (!over){
+            // un log de otro master (o de una partida vieja) no sirve
+            mirror_sync(&mirror, st, (lg && lg->master_pid == master) ? lg : NULL);
+            if (zob) hash = zob->hash;
+        }
         rw_reader_exit(sy);
+        trace_end(TR_PLAYER_SYNC, t_sync, me);
         if (over) break;
 
-        // Elegir direccion aleatoria y enviar 1 byte al master
-        unsigned char dir = (unsigned char)(rand_r(&seed) % 8);
-        ssize_t w = write(STDOUT_FILENO, &dir, 1);
+        // Elegir direccion y enviar 1 byte al master
+        uint64_t t_think = trace_begin();
+        uint64_t deadline = t0 + (uint64_t)budget_ms * 1000000u;
+        int best = -1;
+        if (use_strat){
+            strategy_view_t view = {
+                .size = sizeof(view), .width = st->width, .height = st->height,
+                .num_players = mirror.num_players, .me = me,
+                .players = mirror.players, .board = mirror.board, .hash = hash,
+            };
+            uint64_t now = now_ns();
+            unsigned int left = (now < deadline) ? (unsigned int)((deadline - now) / 1000000u) : 0u;
+            best = strat.choose_move(strat.ctx, &view, left);
+        } else if (mc){
+            best = mcts_search(mc, &mirror, me, deadline);
+        }
+        unsigned char dir = (best >= 0 && best <= 7) ? (unsigned char)best : choose_dir(&mirror, me, &seed);
+        ssize_t w = write(out_fd, &dir, 1);
+        trace_end(TR_PLAYER_THINK, t_think, me);
         if (w < 0){
             if (errno == EPIPE) break; // el máster cerró el pipe
             // en otros errores, intentar continuar
@@ -101,7 +243,15 @@ int main(int argc, char **argv){
     }
 
     // limpieza
+    if (mc){ mcts_report(mc, me); mcts_destroy(mc); }
+    char who[32];
+    snprintf(who, sizeof(who), "player %d", me);
+    spinwait_report(&spin, who);
+    if (use_strat) strategy_unload(&strat);
+    mirror_free(&mirror);
+    ipc_unmap_ext(ext);
     ipc_unmap_sync(sy);
     ipc_unmap_state(st);
+    if (out_fd != STDOUT_FILENO) close(out_fd);
     return 0;
 }
@@ -0,0 +1,253 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#define _POSIX_C_SOURCE 200809L
+#include "shard.h"
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    struct shard_pool *pool;
+    int                id;
+    int                p0, p1;             // bloque de jugadores que decide este hilo
+    int               *bucket;             // jugadas de mi bloque por hilo dueño del destino:
+    int                nbucket[SHARD_MAX_THREADS]; // las del dueño o en bucket[o*(p1-p0) ..]
+    unsigned           active, valid;      // contadores de la ronda
+    unsigned long long tries;
+    pthread_t          th;
+} shard_worker_t;
+
+struct shard_pool {
+    shard_game_t      *g;
+    int                tiles_x;
+    pthread_barrier_t  start, phase;
+    sem_t              go;                 // un post por hilo cuando ya estan todos (o aborted si no)
+    bool               running, quit;
+    bool               aborted;            // no se pudieron crear todos los hilos
+    bool               stop;               // lo escribe el hilo 0 entre barreras
+    shard_strategy_fn *strat;
+    void             **ctx;
+    unsigned           max_idle, idle;
+    shard_worker_t     workers[SHARD_MAX_THREADS];
+};
+
+static int tile_owner(const struct shard_pool *pool, int idx){
+    const shard_game_t *g = pool->g;
+    int x = idx % g->width, y = idx / g->width;
+    int t = (y >> SHARD_TILE_SHIFT) * pool->tiles_x + (x >> SHARD_TILE_SHIFT);
+    return t % g->nthreads;                // baldosas vecinas en hilos distintos reparten la carga
+}
+
+// fase 1: bloqueos del inicio de la ronda y eleccion de destino de mis jugadores
+static void decide(shard_worker_t *w){
+    struct shard_pool *pool = w->pool;
+    shard_game_t *g = pool->g;
+    w->active = 0; w->valid = 0; w->tries = 0;
+    memset(w->nbucket, 0, (size_t)g->nthreads * sizeof(w->nbucket[0]));
+    int span = w->p1 - w->p0;
+    for (int i = w->p0; i < w->p1; ++i){
+        shard_player_t *p = &g->players[i];
+        p->dest = -1;
+        if (p->blocked) continue;
+        if (!engine_has_valid_move(g->board, g->width, g->height, p->x, p->y)){
+            p->blocked = true;
+            continue;
+        }
+        w->active++;
+        w->tries++;
+        int dir = pool->strat[i](g, i, pool->ctx[i]);
+        int idx;
+        // una celda capturada no se libera: si ya no estaba libre al inicio la jugada es invalida
+        if (dir >= 0 && engine_check_move(g->board, g->width, g->height, p->x, p->y, (unsigned)dir, &idx) == MOVE_VALID){
+            p->dest = idx;
+            int o = tile_owner(pool, idx);
+            w->bucket[o * span + w->nbucket[o]++] = i;
+        } else
+            p->inv_moves++;
+    }
+}
+
+// fase 2: aplicar las jugadas con destino en mis baldosas, en orden de id. Solo recorro los
+// baldes que me llenaron en la fase 1; los bloques de jugadores van en orden de hilo y cada
+// balde en orden de id, asi que el orden total es el de id
+static void apply(shard_worker_t *w){
+    struct shard_pool *pool = w->pool;
+    shard_game_t *g = pool->g;
+    for (int t = 0; t < g->nthreads; ++t){
+        const shard_worker_t *c = &pool->workers[t];
+        const int *b = c->bucket + (size_t)w->id * (size_t)(c->p1 - c->p0);
+        for (int k = 0; k < c->nbucket[w->id]; ++k){
+            int i = b[k];
+            shard_player_t *p = &g->players[i];
+            int v = g->board[p->dest];
+            if (v > 0){
+                p->v_moves++;
+                p->score += (unsigned)v;
+                g->board[p->dest] = -i;
+                p->x = p->dest % g->width;
+                p->y = p->dest / g->width;
+                w->valid++;
+            } else {
+                p->inv_moves++;        // se la gano alguien de menor id en esta ronda
+            }
+        }
+    }
+}
+
+static void play_rounds(shard_worker_t *w){
+    struct shard_pool *pool = w->pool;
+    while (true){
+        decide(w);
+        pthread_barrier_wait(&pool->phase);
+        apply(w);
+        pthread_barrier_wait(&pool->phase);
+        if (w->id == 0){
+            shard_game_t *g = pool->g;
+            unsigned active = 0, valid = 0;
+            for (int t = 0; t < g->nthreads; ++t){
+                active += pool->workers[t].active;
+                valid  += pool->workers[t].valid;
+                g->moves += pool->workers[t].tries;
+            }
+            if (active > 0) g->rounds++;
+            pool->idle = valid ? 0 : pool->idle + 1;
+            pool->stop = (active == 0 || pool->idle >= pool->max_idle);
+        }
+        pthread_barrier_wait(&pool->phase);
+        if (pool->stop) break;
+    }
+}
+
+static void *worker_main(void *arg){
+    shard_worker_t *w = arg;
+    struct shard_pool *pool = w->pool;
+    // las barreras son de nthreads: hasta que no esten todos creados no se entra
+    while (sem_wait(&pool->go) != 0) {}
+    if (pool->aborted) return NULL;
+    while (true){
+        pthread_barrier_wait(&pool->start);
+        if (pool->quit) break;
+        play_rounds(w);
+    }
+    return NULL;
+}
+
+int shard_game_init(shard_game_t *g, int W, int H, int nplayers, int nthreads){
+    memset(g, 0, sizeof(*g));
+    if (W < 1 || H < 1 || nplayers < 1 || nthreads < 1) return -1;
+    if (nthreads > SHARD_MAX_THREADS) nthreads = SHARD_MAX_THREADS;
+    g->width = W; g->height = H;
+    g->num_players = nplayers;
+    g->nthreads = nthreads;
+    g->board = malloc((size_t)W * (size_t)H * sizeof(int));
+    g->players = calloc((size_t)nplayers, sizeof(*g->players));
+    g->pool = calloc(1, sizeof(*g->pool));
+    if (!g->board || !g->players || !g->pool){ shard_game_free(g); return -1; }
+
+    struct shard_pool *pool = g->pool;
+    pool->g = g;
+    pool->tiles_x = ((W - 1) >> SHARD_TILE_SHIFT) + 1;
+    for (int t = 0; t < nthreads; ++t){
+        shard_worker_t *w = &pool->workers[t];
+        w->pool = pool; w->id = t;
+        w->p0 = (int)((int64_t)nplayers * t / nthreads);
+        w->p1 = (int)((int64_t)nplayers * (t + 1) / nthreads);
+        w->bucket = malloc((size_t)nthreads * (size_t)(w->p1 - w->p0 + 1) * sizeof(int));
+        if (!w->bucket){ shard_game_free(g); return -1; }
+    }
+    if (sem_init(&pool->go, 0, 0) != 0){ shard_game_free(g); return -1; }
+    pthread_barrier_init(&pool->start, NULL, (unsigned)nthreads);
+    pthread_barrier_init(&pool->phase, NULL, (unsigned)nthreads);
+    int created = 1, rc = 0;
+    while (created < nthreads){
+        rc = pthread_create(&pool->workers[created].th, NULL, worker_main, &pool->workers[created]);
+        if (rc != 0) break;
+        created++;
+    }
+    // si falto alguno, los que arrancaron salen sin tocar las barreras
+    pool->aborted = (created < nthreads);
+    for (int t = 1; t < created; ++t) sem_post(&pool->go);
+    if (pool->aborted){
+        for (int t = 1; t < created; ++t) pthread_join(pool->workers[t].th, NULL);
+        pthread_barrier_destroy(&pool->start);
+        pthread_barrier_destroy(&pool->phase);
+        sem_destroy(&pool->go);
+        shard_game_free(g);
+        errno = rc;
+        return -1;
+    }
+    pool->running = true;
+    return 0;
+}
+
+int shard_game_reset(shard_game_t *g, unsigned int seed){
+    int n = g->num_players;
+    int *px = malloc((size_t)n * sizeof(int)), *py = malloc((size_t)n * sizeof(int));
+    if (!px || !py){ free(px); free(py); return -1; }
+    engine_fill_board(g->board, g->width, g->height, seed, g->nthreads);
+    engine_distribute_positions(n, g->width, g->height, px, py);
+    memset(g->players, 0, (size_t)n * sizeof(*g->players));
+    for (int i = 0; i < n; ++i){
+        // con mas jugadores que celdas de la grilla pueden compartir arranque, como en el master
+        g->players[i].x = px[i];
+        g->players[i].y = py[i];
+        g->board[idx_xy(px[i], py[i], g->width)] = -i;
+    }
+    g->rounds = 0; g->moves = 0;
+    free(px); free(py);
+    return 0;
+}
+
+void shard_game_play(shard_game_t *g, shard_strategy_fn strat[], void *ctx[], unsigned max_idle_rounds){
+    struct shard_pool *pool = g->pool;
+    pool->strat = strat;
+    pool->ctx = ctx;
+    pool->max_idle = max_idle_rounds;
+    pool->idle = 0;
+    pool->stop = false;
+    // el hilo que llama juega como hilo 0
+    pthread_barrier_wait(&pool->start);
+    play_rounds(&pool->workers[0]);
+
+    // el corte deja sin marcar a los que quedaron encerrados en la ultima ronda
+    for (int i = 0; i < g->num_players; ++i){
+        shard_player_t *p = &g->players[i];
+        if (!p->blocked && !engine_has_valid_move(g->board, g->width, g->height, p->x, p->y)) p->blocked = true;
+    }
+}
+
+int shard_game_winner(const shard_game_t *g){
+    int winner = -1;
+    for (int i = 0; i < g->num_players; ++i){
+        if (winner < 0){ winner = i; continue; }
+        const shard_player_t *p = &g->players[i], *w = &g->players[winner];
+        if (p->score > w->score ||
+           (p->score == w->score && p->v_moves > w->v_moves) ||
+           (p->score == w->score && p->v_moves == w->v_moves && p->inv_moves < w->inv_moves))
+            winner = i;
+    }
+    return winner;
+}
+
+void shard_game_free(shard_game_t *g){
+    struct shard_pool *pool = g->pool;
+    if (pool && pool->running){
+        pool->quit = true;
+        pthread_barrier_wait(&pool->start);
+        for (int t = 1; t < g->nthreads; ++t) pthread_join(pool->workers[t].th, NULL);
+        pthread_barrier_destroy(&pool->start);
+        pthread_barrier_destroy(&pool->phase);
+        sem_destroy(&pool->go);
+    }
+    if (pool)
+        for (int t = 0; t < SHARD_MAX_THREADS; ++t) free(pool->workers[t].bucket);
+    free(pool);
+    free(g->players);
+    free(g->board);
+    g->pool = NULL; g->players = NULL; g->board = NULL;
+}
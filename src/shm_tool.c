@@ -2,9 +2,17 @@
 // Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include "ipc.h"    // ipc_create/open/map/unmap/unlink, ipc_init_sync_semaphores
 
 static void usage(const char *p) {
@@ -12,21 +20,124 @@ static void usage(const char *p) {
         "Uso:\n"
         "  %s init <width> <height>\n"
         "  %s open-info\n"
-        "  %s destroy\n", p, p, p);
+        "  %s top [-i intervalo_ms] [-n muestras]\n"
+        "  %s destroy\n", p, p, p, p);
+}
+
+static uint64_t now_ns(void){
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static double rate(double delta, double secs){ return secs > 0 ? delta / secs : 0.0; }
+
+// top: monitor en vivo que no frena al master. Todo se mapea solo lectura y no se toma el
+// lock de lector: el header se copia con el epoch de /game_ext (sin frame, copia suelta)
+// y las tasas salen de la diferencia entre dos muestras
+static int cmd_top(int argc, char **argv){
+    int interval_ms = 1000;
+    long samples = 0;                   // 0 = hasta que termine la partida
+    for (int i = 2; i < argc; i += 2){
+        // cada opcion lleva un numero entero >= 0; sin valor o con basura es un error de uso
+        char *end = NULL;
+        long v = (i + 1 < argc) ? strtol(argv[i + 1], &end, 10) : -1;
+        if (!end || end == argv[i + 1] || *end != '\0' || v < 0 || v > INT_MAX){ usage(argv[0]); return 1; }
+        if (strcmp(argv[i], "-i") == 0) interval_ms = (int)v;
+        else if (strcmp(argv[i], "-n") == 0) samples = v;
+        else { usage(argv[0]); return 1; }
+    }
+    if (interval_ms < 50) interval_ms = 50;
+
+    int fd = shm_open(ipc_shm_name(SHM_STATE), O_RDONLY, 0);
+    if (fd < 0) { perror("open state"); return 1; }
+    const state_t *st = ipc_map_state_fd(fd, false);
+    if (!st) { perror("map state"); return 1; }
+    const ext_header_t *ext = ipc_open_and_map_ext(false);
+    const frame_t *fr = ext_section(ext, EXT_SEC_FRAME, sizeof(frame_t));
+    const lockstats_t *ls = ext_section(ext, EXT_SEC_STATS, sizeof(lockstats_t));
+    pid_t master = ext ? ext->master_pid : 0;
+
+    state_t prev = {0}, cur;           // prev: muestra anterior (la primera no tiene)
+    uint64_t prev_ns = 0, prev_sections = 0, prev_contended = 0, prev_wait = 0;
+    uint32_t prev_epoch = 0;
+    bool tty = isatty(STDOUT_FILENO);
+    for (long n = 0; samples == 0 || n < samples; ++n){
+        uint32_t epoch = fr ? frame_snapshot(fr, st, &cur, sizeof(cur), NULL) : 0;
+        if (!fr) memcpy(&cur, st, sizeof(cur));
+        uint64_t t = now_ns();
+        double secs = n ? (double)(t - prev_ns) / 1e9 : 0.0;
+        bool alive = master > 0 && kill(master, 0) == 0;
+
+        if (tty) printf("\033[H\033[2J");
+        else if (n) printf("\n");
+        printf("chomp top  %ux%u  jugadores=%u  master=%d%s%s\n", cur.width, cur.height, cur.num_players,
+               (int)master, alive ? "" : " (no corre)", cur.game_over ? "  [terminada]" : "");
+
+        unsigned long long moves = 0, prev_moves = 0;
+        for (unsigned i = 0; i < cur.num_players && i < MAX_PLAYERS; ++i){
+            moves += cur.players[i].v_moves + cur.players[i].inv_moves;
+            if (n) prev_moves += prev.players[i].v_moves + prev.players[i].inv_moves;
+        }
+        printf("jugadas/s=%.0f  cuadros/s=%.0f\n",
+               n ? rate((double)(moves - prev_moves), secs) : 0.0,
+               (n && fr) ? rate((double)((epoch - prev_epoch) / 2u), secs) : 0.0);
+        if (ls){
+            uint64_t sections = atomic_load_explicit(&ls->writer_sections, memory_order_relaxed);
+            uint64_t contended = atomic_load_explicit(&ls->writer_contended, memory_order_relaxed);
+            uint64_t wait = atomic_load_explicit(&ls->writer_wait_ns, memory_order_relaxed);
+            uint64_t ds = sections - prev_sections;
+            printf("lock escritor: secciones/s=%.0f  con lectores=%.1f%%  espera media=%.2fus  max=%.1fus\n",
+                   n ? rate((double)ds, secs) : 0.0,
+                   (n && ds) ? 100.0 * (double)(contended - prev_contended) / (double)ds : 0.0,
+                   (n && ds) ? (double)(wait - prev_wait) / (double)ds / 1e3 : 0.0,
+                   (double)atomic_load_explicit(&ls->writer_max_wait_ns, memory_order_relaxed) / 1e3);
+            prev_sections = sections; prev_contended = contended; prev_wait = wait;
+        } else {
+            printf("lock escritor: sin contadores en /game_ext\n");
+        }
+
+        printf("\n%-10s %7s %8s %8s %8s %9s %7s %6s %11s %s\n",
+               "jugador", "pid", "score", "score/s", "validas", "invalidas", "%valid", "jug/s", "pos", "estado");
+        for (unsigned i = 0; i < cur.num_players && i < MAX_PLAYERS; ++i){
+            const player_t *p = &cur.players[i], *q = &prev.players[i];
+            unsigned tot = p->v_moves + p->inv_moves;
+            char pos[24];
+            snprintf(pos, sizeof(pos), "(%u,%u)", (unsigned)p->pos_x, (unsigned)p->pos_y);
+            printf("%-10.10s %7d %8u %8.1f %8u %9u %6.1f%% %6.1f %11s %s\n",
+                   p->name[0] ? p->name : "?", (int)p->player_pid, p->score,
+                   n ? rate((double)p->score - (double)q->score, secs) : 0.0,
+                   p->v_moves, p->inv_moves, tot ? 100.0 * (double)p->v_moves / (double)tot : 0.0,
+                   n ? rate((double)tot - (double)(q->v_moves + q->inv_moves), secs) : 0.0,
+                   pos, p->blocked ? "bloqueado" : "activo");
+        }
+        fflush(stdout);
+
+        prev = cur; prev_ns = t; prev_epoch = epoch;
+        if (cur.game_over || !alive) break;
+        struct timespec ts = { interval_ms / 1000, (long)(interval_ms % 1000) * 1000000L };
+        nanosleep(&ts, NULL);
+    }
+
+    ipc_unmap_ext(ext);
+    ipc_unmap_state((state_t*)st);
+    return 0;
 }
 
 int main(int argc, char **argv) {
     if (argc < 2) { usage(argv[0]); return 1; }
 
-    // subcmd destroy -> unlink ambas shm
+    // subcmd destroy -> unlink ambas shm (y las extensiones propias si existen)
     if (strcmp(argv[1], "destroy") == 0) {
         int e1 = ipc_unlink_state();
         int e2 = ipc_unlink_sync();
         printf("unlink state: %s\n", e1==0?"ok":"err");
         printf("unlink sync : %s\n", e2==0?"ok":"err");
+        ipc_unlink_ext();
         return (e1==0 && e2==0) ? 0 : 1;
     }
 
+    if (strcmp(argv[1], "top") == 0) return cmd_top(argc, argv);
+
     // subcmd init <W> <H> -> crea ambas shm, inicializa semaforos si es necesario
     if (strcmp(argv[1], "init") == 0) {
         if (argc != 4) { usage(argv[0]); return 1; }
@@ -72,6 +183,26 @@ int main(int argc, char **argv) {
         if (!st) { perror("open state"); return 1; }
         printf("state: %ux%u, players=%u, game_over=%d\n",
                st->width, st->height, st->num_players, st->game_over);
+        // arena de extensiones: la tabla de secciones tal como la publico el master
+        const ext_header_t *ext = ipc_open_and_map_ext(false);
+        if (!ext) {
+            printf("ext  : %s\n", errno == EPROTO ? "formato desconocido" : "no existe");
+            ipc_unmap_state(st);
+            return 0;
+        }
+        printf("ext  : v%u, %llu bytes, master=%d, %u secciones\n", ext->version,
+               (unsigned long long)ext->total_size, (int)ext->master_pid, ext->nsections);
+        for (uint32_t i = 0; i < ext->nsections; ++i)
+            printf("  id=%-3u offset=%-8llu size=%llu\n", ext->sections[i].id,
+                   (unsigned long long)ext->sections[i].offset, (unsigned long long)ext->sections[i].size);
+        // hash publicado contra el recalculado (sin lock: con la partida en curso puede diferir)
+        const zobrist_t *zob = ext_section(ext, EXT_SEC_ZOBRIST, sizeof(zobrist_t));
+        if (zob) {
+            unsigned long long full = zobrist_full(st);
+            printf("zobrist: %016llx, recalculado %016llx (%s)\n", zob->hash, full,
+                   zob->hash == full ? "igual" : "distinto");
+        }
+        ipc_unmap_ext(ext);
         ipc_unmap_state(st);
         return 0;
     }
@@ -0,0 +1,356 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+// simulate: juega partidas completas en memoria con el motor, sin procesos, shm ni syscalls
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <getopt.h>
+#include "engine.h"
+#include "strategy.h"
+#include "shard.h"
+
+static void usage(const char *p){
+    fprintf(stderr,
+        "Uso: %s -w ancho -h alto [-C | -N jugadores] [-g partidas] [-j hilos] [-s semilla] [-r rondas_ociosas] jugador1 [jugador2 ...]\n"
+        "  jugador: random | greedy | ruta a una estrategia .so (ver include/strategy.h)\n"
+        "  -C: tablero por bloques materializados al tocarlos (hasta 2^32-1 de lado, solo random/greedy)\n"
+        "  -N: partidas de N jugadores (los tipos se repiten en orden) aplicadas por -j hilos\n"
+        "      que se reparten el tablero en baldosas (solo random/greedy)\n", p);
+}
+
+static uint64_t now_ns(void){
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// estrategias internas
+static uint32_t rng_next(uint64_t *s){
+    uint64_t x = *s;
+    x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+    *s = x;
+    return (uint32_t)((x * 2685821657736338717ull) >> 32);
+}
+
+// al azar entre los vecinos libres (como el jugador sin busqueda)
+static int strat_random(const engine_game_t *g, int me, void *ctx){
+    const player_t *p = &g->players[me];
+    const int *c = g->pad.cells + padboard_idx(&g->pad, p->pos_x, p->pos_y);
+    int dirs[8], n = 0;
+    for (int d = 0; d < 8; ++d)
+        if (c[g->pad.nb[d]] > 0) dirs[n++] = d;
+    if (n == 0) return 0;
+    return dirs[rng_next(ctx) % (unsigned)n];
+}
+
+// vecino libre de mayor recompensa
+static int strat_greedy(const engine_game_t *g, int me, void *ctx){
+    (void)ctx;
+    const player_t *p = &g->players[me];
+    const int *c = g->pad.cells + padboard_idx(&g->pad, p->pos_x, p->pos_y);
+    int best = 0, best_val = 0;
+    for (int d = 0; d < 8; ++d){
+        int v = c[g->pad.nb[d]];        // el borde es PAD_WALL: nunca gana
+        if (v > best_val){ best_val = v; best = d; }
+    }
+    return best;
+}
+
+// mismas estrategias sobre el tablero por bloques (-C)
+static int cstrat_random(engine_cgame_t *g, int me, void *ctx){
+    const engine_cplayer_t *p = &g->players[me];
+    int dirs[8], n = 0;
+    for (int d = 0; d < 8; ++d){
+        int64_t nx = (int64_t)p->x + DX[d], ny = (int64_t)p->y + DY[d];
+        if (nx < 0 || ny < 0 || nx >= g->board.width || ny >= g->board.height) continue;
+        if (cb_get(&g->board, (uint32_t)nx, (uint32_t)ny) > 0) dirs[n++] = d;
+    }
+    if (n == 0) return 0;
+    return dirs[rng_next(ctx) % (unsigned)n];
+}
+
+static int cstrat_greedy(engine_cgame_t *g, int me, void *ctx){
+    (void)ctx;
+    const engine_cplayer_t *p = &g->players[me];
+    int best = 0, best_val = 0;
+    for (int d = 0; d < 8; ++d){
+        int64_t nx = (int64_t)p->x + DX[d], ny = (int64_t)p->y + DY[d];
+        if (nx < 0 || ny < 0 || nx >= g->board.width || ny >= g->board.height) continue;
+        int v = cb_get(&g->board, (uint32_t)nx, (uint32_t)ny);
+        if (v > best_val){ best_val = v; best = d; }
+    }
+    return best;
+}
+
+// mismas estrategias para partidas por baldosas (-N)
+static int sstrat_random(const shard_game_t *g, int me, void *ctx){
+    const shard_player_t *p = &g->players[me];
+    int dirs[8], n = 0;
+    for (int d = 0; d < 8; ++d){
+        int nx = p->x + DX[d], ny = p->y + DY[d];
+        if (in_bounds(nx, ny, g->width, g->height) && g->board[idx_xy(nx, ny, g->width)] > 0) dirs[n++] = d;
+    }
+    if (n == 0) return 0;
+    return dirs[rng_next(ctx) % (unsigned)n];
+}
+
+static int sstrat_greedy(const shard_game_t *g, int me, void *ctx){
+    (void)ctx;
+    const shard_player_t *p = &g->players[me];
+    int best = 0, best_val = 0;
+    for (int d = 0; d < 8; ++d){
+        int nx = p->x + DX[d], ny = p->y + DY[d];
+        if (!in_bounds(nx, ny, g->width, g->height)) continue;
+        int v = g->board[idx_xy(nx, ny, g->width)];
+        if (v > best_val){ best_val = v; best = d; }
+    }
+    return best;
+}
+
+// adaptador para estrategias .so: arma la vista de solo lectura sobre la partida
+typedef struct { const strategy_t *so; void *ctx; } so_ctx_t;
+
+static int strat_so(const engine_game_t *g, int me, void *ctx){
+    so_ctx_t *c = ctx;
+    strategy_view_t view = {
+        .size = sizeof(view), .width = (unsigned short)g->width, .height = (unsigned short)g->height,
+        .num_players = (unsigned int)g->num_players, .me = me,
+        .players = g->players, .board = g->board,
+    };
+    return c->so->choose_move(c->ctx, &view, 0);
+}
+
+// configuracion compartida por todos los hilos
+typedef struct {
+    uint32_t      W, H;
+    int           nplayers;
+    int           chunked;              // -C
+    unsigned      games;
+    unsigned      seed;
+    unsigned      max_idle;
+    const char   *spec[MAX_PLAYERS];
+    strategy_t    so[MAX_PLAYERS];      // cargadas una vez por proceso
+    atomic_uint   next;                 // proxima partida a jugar
+} sim_cfg_t;
+
+typedef struct {
+    sim_cfg_t         *cfg;
+    int                id;
+    pthread_t          th;
+    unsigned long long games, moves;
+    unsigned long long wins[MAX_PLAYERS];
+    unsigned long long score[MAX_PLAYERS];
+    size_t             board_bytes;     // maximo de memoria de tablero en una partida
+    int                err;
+} sim_worker_t;
+
+// partidas con tablero por bloques: sin tablero denso ni estrategias .so
+static void *sim_main_chunked(void *arg){
+    sim_worker_t *w = arg;
+    sim_cfg_t *cfg = w->cfg;
+    engine_cgame_t g;
+    if (engine_cgame_init(&g, cfg->W, cfg->H, cfg->nplayers) != 0){ w->err = 1; return NULL; }
+
+    engine_cstrategy_fn fn[MAX_PLAYERS];
+    void *ctx[MAX_PLAYERS];
+    uint64_t rng[MAX_PLAYERS];
+    for (int i = 0; i < cfg->nplayers; ++i){
+        rng[i] = (uint64_t)0x9E3779B97F4A7C15ull * (uint64_t)(w->id * MAX_PLAYERS + i + 1) ^ cfg->seed;
+        fn[i] = (strcmp(cfg->spec[i], "greedy") == 0) ? cstrat_greedy : cstrat_random;
+        ctx[i] = &rng[i];
+    }
+
+    unsigned k;
+    while ((k = atomic_fetch_add(&cfg->next, 1u)) < cfg->games){
+        if (engine_cgame_reset(&g, cfg->seed + k) != 0){ perror("simulate: bloque inicial"); w->err = 1; break; }
+        engine_cgame_play(&g, fn, ctx, cfg->max_idle);
+        w->games++;
+        w->moves += g.moves;
+        int win = engine_cgame_winner(&g);
+        if (win >= 0) w->wins[win]++;
+        for (int i = 0; i < g.num_players; ++i) w->score[i] += g.players[i].score;
+        size_t bytes = cb_bytes(&g.board);
+        if (bytes > w->board_bytes) w->board_bytes = bytes;
+    }
+    engine_cgame_free(&g);
+    return NULL;
+}
+
+static void *sim_main(void *arg){
+    sim_worker_t *w = arg;
+    sim_cfg_t *cfg = w->cfg;
+    engine_game_t g;
+    if (engine_game_init(&g, (int)cfg->W, (int)cfg->H, cfg->nplayers) != 0){ w->err = 1; return NULL; }
+    w->board_bytes = (size_t)cfg->W * (size_t)cfg->H * sizeof(int);
+
+    engine_strategy_fn fn[MAX_PLAYERS];
+    void *ctx[MAX_PLAYERS];
+    uint64_t rng[MAX_PLAYERS];
+    so_ctx_t soc[MAX_PLAYERS];
+    int ready = 0;                      // jugadores con la estrategia inicializada
+    for (; ready < cfg->nplayers; ++ready){
+        int i = ready;
+        rng[i] = (uint64_t)0x9E3779B97F4A7C15ull * (uint64_t)(w->id * MAX_PLAYERS + i + 1) ^ cfg->seed;
+        if (strcmp(cfg->spec[i], "random") == 0){ fn[i] = strat_random; ctx[i] = &rng[i]; }
+        else if (strcmp(cfg->spec[i], "greedy") == 0){ fn[i] = strat_greedy; ctx[i] = NULL; }
+        else {
+            // un contexto por hilo y jugador, reusado entre partidas del mismo tamaño
+            soc[i].so = &cfg->so[i];
+            if (cfg->so[i].init((unsigned short)cfg->W, (unsigned short)cfg->H, i, &soc[i].ctx) != 0){ w->err = 1; break; }
+            fn[i] = strat_so; ctx[i] = &soc[i];
+        }
+    }
+
+    unsigned k;
+    // si alguna estrategia no arranco no se juega: solo se cierran las que si
+    while (!w->err && (k = atomic_fetch_add(&cfg->next, 1u)) < cfg->games){
+        engine_game_reset(&g, cfg->seed + k);
+        engine_game_play(&g, fn, ctx, cfg->max_idle);
+        w->games++;
+        w->moves += g.moves;
+        int win = engine_winner(g.players, g.num_players);
+        if (win >= 0) w->wins[win]++;
+        for (int i = 0; i < g.num_players; ++i) w->score[i] += g.players[i].score;
+    }
+
+    for (int i = 0; i < ready; ++i)
+        if (fn[i] == strat_so && cfg->so[i].shutdown) cfg->so[i].shutdown(soc[i].ctx);
+    engine_game_free(&g);
+    return NULL;
+}
+
+// -N: una partida por vez con muchos jugadores, cada una aplicada en paralelo por baldosas.
+// Los resultados se agrupan por tipo de jugador (el jugador i es del tipo i % tipos)
+static int run_sharded(const sim_cfg_t *cfg, int nplayers, int threads){
+    shard_game_t g;
+    if (shard_game_init(&g, (int)cfg->W, (int)cfg->H, nplayers, threads) != 0){ perror("simulate: shard"); return 1; }
+    shard_strategy_fn *fn = malloc((size_t)nplayers * sizeof(*fn));
+    void **ctx = malloc((size_t)nplayers * sizeof(*ctx));
+    uint64_t *rng = malloc((size_t)nplayers * sizeof(*rng));
+    if (!fn || !ctx || !rng){ perror("malloc"); free(fn); free(ctx); free(rng); shard_game_free(&g); return 1; }
+    for (int i = 0; i < nplayers; ++i){
+        fn[i] = (strcmp(cfg->spec[i % cfg->nplayers], "greedy") == 0) ? sstrat_greedy : sstrat_random;
+        rng[i] = (uint64_t)0x9E3779B97F4A7C15ull * (uint64_t)(i + 1) ^ cfg->seed;
+        ctx[i] = &rng[i];
+    }
+
+    unsigned long long moves = 0, rounds = 0, wins[MAX_PLAYERS] = {0}, score[MAX_PLAYERS] = {0};
+    uint64_t t0 = now_ns();
+    for (unsigned k = 0; k < cfg->games; ++k){
+        if (shard_game_reset(&g, cfg->seed + k) != 0){
+            perror("simulate: shard reset");
+            free(fn); free(ctx); free(rng);
+            shard_game_free(&g);
+            return 1;
+        }
+        shard_game_play(&g, fn, ctx, cfg->max_idle);
+        moves += g.moves;
+        rounds += g.rounds;
+        int win = shard_game_winner(&g);
+        if (win >= 0) wins[win % cfg->nplayers]++;
+        for (int i = 0; i < nplayers; ++i) score[i % cfg->nplayers] += g.players[i].score;
+    }
+    double secs = (double)(now_ns() - t0) / 1e9;
+
+    printf("simulate: %u partidas %ux%u por baldosas, %d jugadores, %d hilos, semilla %u\n",
+           cfg->games, cfg->W, cfg->H, nplayers, g.nthreads, cfg->seed);
+    printf("tiempo=%.3fs partidas/s=%.1f jugadas/s=%.0f rondas/partida=%.1f\n",
+           secs, secs > 0 ? (double)cfg->games / secs : 0.0, secs > 0 ? (double)moves / secs : 0.0,
+           cfg->games ? (double)rounds / (double)cfg->games : 0.0);
+    for (int t = 0; t < cfg->nplayers; ++t){
+        int of_type = nplayers / cfg->nplayers + (t < nplayers % cfg->nplayers);
+        printf("tipo %d (%s, %d jugadores): victorias=%llu score medio=%.1f\n", t, cfg->spec[t], of_type, wins[t],
+               (cfg->games && of_type) ? (double)score[t] / (double)cfg->games / of_type : 0.0);
+    }
+    free(fn); free(ctx); free(rng);
+    shard_game_free(&g);
+    return 0;
+}
+
+int main(int argc, char **argv){
+    sim_cfg_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.games = 1000;
+    cfg.seed = (unsigned)time(NULL);
+    cfg.max_idle = 100;
+    int threads = 1;
+    int sharded = 0;                    // -N: cantidad de jugadores por partida
+
+    int opt;
+    unsigned long w_arg = 0, h_arg = 0;
+    while ((opt = getopt(argc, argv, "w:h:g:j:s:r:CN:")) != -1){
+        switch (opt){
+            case 'w': w_arg = strtoul(optarg, NULL, 10); break;
+            case 'h': h_arg = strtoul(optarg, NULL, 10); break;
+            case 'C': cfg.chunked = 1; break;
+            case 'N': sharded = (int)strtol(optarg, NULL, 10); break;
+            case 'g': cfg.games = (unsigned)strtoul(optarg, NULL, 10); break;
+            case 'j': threads = (int)strtol(optarg, NULL, 10); break;
+            case 's': cfg.seed = (unsigned)strtoul(optarg, NULL, 10); break;
+            case 'r': cfg.max_idle = (unsigned)strtoul(optarg, NULL, 10); break;
+            default: usage(argv[0]); return 1;
+        }
+    }
+    while (optind < argc && cfg.nplayers < MAX_PLAYERS) cfg.spec[cfg.nplayers++] = argv[optind++];
+    unsigned long max_side = cfg.chunked ? UINT32_MAX : 65535;
+    if (w_arg < 1 || h_arg < 1 || w_arg > max_side || h_arg > max_side || cfg.nplayers == 0 || threads < 1 ||
+        sharded < 0 || (sharded && cfg.chunked)){
+        usage(argv[0]);
+        return 1;
+    }
+    cfg.W = (uint32_t)w_arg; cfg.H = (uint32_t)h_arg;
+    atomic_init(&cfg.next, 0u);
+
+    for (int i = 0; i < cfg.nplayers; ++i){
+        if (strcmp(cfg.spec[i], "random") == 0 || strcmp(cfg.spec[i], "greedy") == 0) continue;
+        if (cfg.chunked || sharded){ fprintf(stderr, "simulate: -C y -N solo admiten random y greedy\n"); return 1; }
+        if (strategy_load(&cfg.so[i], cfg.spec[i]) != 0){
+            // las cargadas antes no llegaron a init: se descargan sin shutdown
+            for (int j = 0; j < i; ++j){ cfg.so[j].shutdown = NULL; strategy_unload(&cfg.so[j]); }
+            return 1;
+        }
+    }
+
+    if (sharded) return run_sharded(&cfg, sharded, threads);
+
+    sim_worker_t *ws = calloc((size_t)threads, sizeof(*ws));
+    if (!ws){ perror("calloc"); return 1; }
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < threads; ++i){
+        ws[i].cfg = &cfg; ws[i].id = i;
+        if (pthread_create(&ws[i].th, NULL, cfg.chunked ? sim_main_chunked : sim_main, &ws[i]) != 0){ perror("pthread_create"); return 1; }
+    }
+    unsigned long long games = 0, moves = 0, wins[MAX_PLAYERS] = {0}, score[MAX_PLAYERS] = {0};
+    size_t board_bytes = 0;
+    int err = 0;
+    for (int i = 0; i < threads; ++i){
+        pthread_join(ws[i].th, NULL);
+        err |= ws[i].err;
+        if (ws[i].board_bytes > board_bytes) board_bytes = ws[i].board_bytes;
+        games += ws[i].games; moves += ws[i].moves;
+        for (int p = 0; p < cfg.nplayers; ++p){ wins[p] += ws[i].wins[p]; score[p] += ws[i].score[p]; }
+    }
+    double secs = (double)(now_ns() - t0) / 1e9;
+    if (err) fprintf(stderr, "simulate: algun hilo no pudo inicializar su partida\n");
+
+    printf("simulate: %llu partidas %ux%u%s, %d jugadores, %d hilos, semilla %u\n",
+           games, cfg.W, cfg.H, cfg.chunked ? " (por bloques)" : "", cfg.nplayers, threads, cfg.seed);
+    printf("memoria de tablero por partida: %.1f KiB (max)\n", (double)board_bytes / 1024.0);
+    printf("tiempo=%.3fs partidas/s=%.0f jugadas/s=%.0f\n",
+           secs, secs > 0 ? (double)games / secs : 0.0, secs > 0 ? (double)moves / secs : 0.0);
+    for (int p = 0; p < cfg.nplayers; ++p){
+        printf("jugador %d (%s): victorias=%llu (%.1f%%) score medio=%.1f\n", p, cfg.spec[p], wins[p],
+               games ? 100.0 * (double)wins[p] / (double)games : 0.0,
+               games ? (double)score[p] / (double)games : 0.0);
+    }
+
+    for (int i = 0; i < cfg.nplayers; ++i){ cfg.so[i].shutdown = NULL; strategy_unload(&cfg.so[i]); }
+    free(ws);
+    return err ? 1 : 0;
+}
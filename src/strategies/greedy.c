@@ -0,0 +1,35 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+// Estrategia de ejemplo para -S: va siempre a la celda vecina libre de mayor recompensa
+#include <stdlib.h>
+#include "strategy.h"
+
+unsigned int strategy_abi_version(void);
+int  strategy_init(unsigned short width, unsigned short height, int me, void **ctx);
+int  strategy_choose_move(void *ctx, const strategy_view_t *view, unsigned int budget_ms);
+void strategy_shutdown(void *ctx);
+
+unsigned int strategy_abi_version(void){ return STRATEGY_ABI_VERSION; }
+
+int strategy_init(unsigned short width, unsigned short height, int me, void **ctx){
+    (void)width; (void)height; (void)me;
+    *ctx = NULL;    // no necesita estado
+    return 0;
+}
+
+int strategy_choose_move(void *ctx, const strategy_view_t *v, unsigned int budget_ms){
+    (void)ctx; (void)budget_ms;
+    const player_t *p = &v->players[v->me];
+    int best = -1, best_val = 0;
+    for (int d = 0; d < 8; ++d){
+        int nx = (int)p->pos_x + DX[d], ny = (int)p->pos_y + DY[d];
+        if (!in_bounds(nx, ny, v->width, v->height)) continue;
+        int val = v->board[idx_xy(nx, ny, v->width)];
+        if (val > best_val){ best_val = val; best = d; }
+    }
+    return best;
+}
+
+void strategy_shutdown(void *ctx){ (void)ctx; }
@@ -0,0 +1,48 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "strategy.h"
+#include <dlfcn.h>
+#include <stdio.h>
+#include <string.h>
+
+// dlsym devuelve void*, se copia al puntero a funcion para no depender de un cast directo
+static int resolve(void *handle, const char *name, void *out, size_t sz){
+    void *sym = dlsym(handle, name);
+    if (!sym) return -1;
+    memcpy(out, &sym, sz);
+    return 0;
+}
+
+int strategy_load(strategy_t *s, const char *path){
+    memset(s, 0, sizeof(*s));
+    s->handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (!s->handle) {
+        fprintf(stderr, "strategy: dlopen %s: %s\n", path, dlerror());
+        return -1;
+    }
+
+    strategy_abi_fn abi = NULL;
+    if (resolve(s->handle, "strategy_abi_version", &abi, sizeof(abi)) != 0 ||
+        abi() != STRATEGY_ABI_VERSION) {
+        fprintf(stderr, "strategy: %s no exporta la version de ABI %u\n", path, STRATEGY_ABI_VERSION);
+        dlclose(s->handle); s->handle = NULL;
+        return -1;
+    }
+    if (resolve(s->handle, "strategy_init", &s->init, sizeof(s->init)) != 0 ||
+        resolve(s->handle, "strategy_choose_move", &s->choose_move, sizeof(s->choose_move)) != 0) {
+        fprintf(stderr, "strategy: %s: falta strategy_init o strategy_choose_move\n", path);
+        dlclose(s->handle); s->handle = NULL;
+        return -1;
+    }
+    (void)resolve(s->handle, "strategy_shutdown", &s->shutdown, sizeof(s->shutdown));
+    return 0;
+}
+
+void strategy_unload(strategy_t *s){
+    if (!s->handle) return;
+    if (s->shutdown) s->shutdown(s->ctx);
+    dlclose(s->handle);
+    memset(s, 0, sizeof(*s));
+}
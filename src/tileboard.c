@@ -0,0 +1,64 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "tileboard.h"
+#include <stdlib.h>
+#include <string.h>
+
+int tb_init(tileboard_t *b, int W, int H){
+    b->width = W; b->height = H;
+    b->tiles_x = (W + TB_SIDE - 1) / TB_SIDE;
+    int tiles_y = (H + TB_SIDE - 1) / TB_SIDE;
+    b->cells = calloc((size_t)b->tiles_x * (size_t)tiles_y * TB_CELLS, sizeof(int));
+    return b->cells ? 0 : -1;
+}
+
+void tb_free(tileboard_t *b){
+    free(b->cells);
+    b->cells = NULL;
+}
+
+void tb_load(tileboard_t *b, const int *flat){
+    for (int y = 0; y < b->height; ++y)
+        for (int x = 0; x < b->width; ++x)
+            b->cells[tb_idx(b, x, y)] = flat[idx_xy(x, y, b->width)];
+}
+
+void tb_store(const tileboard_t *b, int *flat){
+    for (int y = 0; y < b->height; ++y)
+        for (int x = 0; x < b->width; ++x)
+            flat[idx_xy(x, y, b->width)] = b->cells[tb_idx(b, x, y)];
+}
+
+bool tb_has_valid_move(const tileboard_t *b, int x, int y){
+    for (int d = 0; d < 8; ++d){
+        int nx = x + DX[d], ny = y + DY[d];
+        if (!in_bounds(nx, ny, b->width, b->height)) continue;
+        if (b->cells[tb_idx(b, nx, ny)] > 0) return true;
+    }
+    return false;
+}
+
+// seen se indexa como cells: las marcas de una misma zona tambien quedan juntas.
+// En la pila van indices fila por fila, que se pasan a (x,y) mas barato que un indice Z
+int tb_flood_count(const tileboard_t *b, int x, int y, int *stack, uint8_t *seen){
+    int W = b->width, H = b->height;
+    int top = 0, count = 0;
+    stack[top++] = idx_xy(x, y, W);
+    seen[tb_idx(b, x, y)] = 1;
+    while (top > 0){
+        int c = stack[--top];
+        int cx = c % W, cy = c / W;
+        for (int d = 0; d < 8; ++d){
+            int nx = cx + DX[d], ny = cy + DY[d];
+            if (!in_bounds(nx, ny, W, H)) continue;
+            int t = tb_idx(b, nx, ny);
+            if (seen[t] || b->cells[t] <= 0) continue;
+            seen[t] = 1;
+            stack[top++] = idx_xy(nx, ny, W);
+            count++;
+        }
+    }
+    return count;
+}
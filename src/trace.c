@@ -0,0 +1,181 @@
+// This is a personal academic project.
+// Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "trace.h"
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TRACE_MAGIC 0x43525443u        // "CTRC"
+
+typedef struct {
+    uint64_t start_ns;
+    uint64_t dur_ns;
+    int16_t  span;
+    int16_t  arg;
+    uint32_t _pad;
+} trace_rec_t;
+
+// Encabezado de cada volcado CHOMP_TRACE.<pid>
+typedef struct {
+    uint32_t magic;
+    uint32_t n;
+    uint64_t dropped;
+    int32_t  pid;
+    char     who[28];
+} trace_file_t;
+
+static const char *span_names[TR_NSPANS] = {
+    "select", "leer jugada", "seccion de escritor", "repaint A/B",
+    "espera A", "copia del estado", "render",
+    "espera G", "lectura del estado", "eleccion",
+};
+
+bool trace_enabled = false;
+static const char  *trace_path = NULL;
+static char         trace_who[28];
+static trace_rec_t *recs = NULL;
+static uint32_t     nrecs = 0, caprecs = 0;
+static uint64_t     dropped = 0;
+static bool         flushed = false;
+
+void trace_init(const char *who){
+    trace_path = getenv(TRACE_ENV);
+    if (!trace_path || !trace_path[0]) return;
+    snprintf(trace_who, sizeof(trace_who), "%s", who);
+    caprecs = 4096;
+    recs = malloc(caprecs * sizeof(*recs));
+    if (!recs){ perror("trace: malloc"); return; }
+    trace_enabled = true;
+    atexit(trace_flush);
+}
+
+void trace_record(trace_span_t s, uint64_t t0, int arg){
+    if (nrecs == caprecs){
+        // crece de a potencias de 2 fuera del camino comun; llegado al tope se cuenta y se pierde
+        uint32_t cap = caprecs * 2u;
+        trace_rec_t *p = (cap <= TRACE_MAX_RECS) ? realloc(recs, cap * sizeof(*recs)) : NULL;
+        if (!p){ dropped++; return; }
+        recs = p; caprecs = cap;
+    }
+    uint64_t now = trace_begin();
+    recs[nrecs++] = (trace_rec_t){ t0, now > t0 ? now - t0 : 0, (int16_t)s, (int16_t)arg, 0 };
+}
+
+void trace_flush(void){
+    if (!trace_enabled || flushed) return;
+    flushed = true;
+    char name[4096];
+    snprintf(name, sizeof(name), "%s.%d", trace_path, (int)getpid());
+    FILE *f = fopen(name, "wb");
+    if (!f){ perror("trace: volcado"); return; }
+    trace_file_t h = { TRACE_MAGIC, nrecs, dropped, (int32_t)getpid(), {0} };
+    memcpy(h.who, trace_who, sizeof(h.who));
+    if (fwrite(&h, sizeof(h), 1, f) != 1 || fwrite(recs, sizeof(*recs), nrecs, f) != nrecs)
+        perror("trace: volcado");
+    fclose(f);
+}
+
+// Recorre los CHOMP_TRACE.<pid> del directorio de CHOMP_TRACE; fn recibe la ruta completa
+static void for_each_dump(void (*fn)(const char *path, void *ctx), void *ctx){
+    char dir[4096];
+    const char *slash = strrchr(trace_path, '/');
+    const char *base = slash ? slash + 1 : trace_path;
+    if (slash) snprintf(dir, sizeof(dir), "%.*s", (int)(slash - trace_path), trace_path);
+    else snprintf(dir, sizeof(dir), ".");
+    if (!dir[0]) snprintf(dir, sizeof(dir), "/");
+    size_t blen = strlen(base);
+
+    DIR *d = opendir(dir);
+    if (!d){ perror("trace: opendir"); return; }
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL){
+        const char *n = e->d_name;
+        if (strncmp(n, base, blen) != 0 || n[blen] != '.' || !n[blen + 1]) continue;
+        if (strspn(n + blen + 1, "0123456789") != strlen(n + blen + 1)) continue;
+        char path[8192];
+        snprintf(path, sizeof(path), "%s/%s", dir, n);
+        fn(path, ctx);
+    }
+    closedir(d);
+}
+
+static void remove_dump(const char *path, void *ctx){ (void)ctx; unlink(path); }
+
+void trace_discard_stale(void){
+    if (trace_enabled) for_each_dump(remove_dump, NULL);
+}
+
+typedef struct {
+    FILE    *out;
+    bool     first;
+    uint64_t base_ns;       // el primer tramo de la corrida es el t=0 del timeline
+    int      procs;
+    uint64_t events, lost;
+} merge_t;
+
+static void find_base(const char *path, void *ctx){
+    merge_t *m = ctx;
+    FILE *f = fopen(path, "rb");
+    if (!f) return;
+    trace_file_t h;
+    trace_rec_t r;
+    // los tramos se anotan al cerrar: uno de afuera queda despues de los de adentro
+    if (fread(&h, sizeof(h), 1, f) == 1 && h.magic == TRACE_MAGIC){
+        for (uint32_t i = 0; i < h.n && fread(&r, sizeof(r), 1, f) == 1; ++i)
+            if (m->base_ns == 0 || r.start_ns < m->base_ns) m->base_ns = r.start_ns;
+    }
+    fclose(f);
+}
+
+static void emit_dump(const char *path, void *ctx){
+    merge_t *m = ctx;
+    FILE *f = fopen(path, "rb");
+    if (!f){ perror("trace: leer volcado"); return; }
+    trace_file_t h;
+    if (fread(&h, sizeof(h), 1, f) != 1 || h.magic != TRACE_MAGIC){
+        fprintf(stderr, "trace: %s no es un volcado valido\n", path);
+        fclose(f);
+        return;
+    }
+    h.who[sizeof(h.who) - 1] = '\0';
+    fprintf(m->out, "%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            m->first ? "" : ",\n", h.pid, h.pid, h.who);
+    m->first = false;
+    trace_rec_t r;
+    for (uint32_t i = 0; i < h.n && fread(&r, sizeof(r), 1, f) == 1; ++i){
+        if (r.span < 0 || r.span >= TR_NSPANS) continue;
+        uint64_t ts = r.start_ns > m->base_ns ? r.start_ns - m->base_ns : 0;
+        fprintf(m->out, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d",
+                span_names[r.span], h.who, (double)ts / 1e3, (double)r.dur_ns / 1e3, h.pid, h.pid);
+        if (r.arg >= 0) fprintf(m->out, ",\"args\":{\"jugador\":%d}", r.arg);
+        fputc('}', m->out);
+        m->events++;
+    }
+    m->lost += h.dropped;
+    m->procs++;
+    fclose(f);
+    unlink(path);
+}
+
+int trace_merge(void){
+    if (!trace_enabled) return 0;
+    merge_t m = { .first = true };
+    m.out = fopen(trace_path, "w");
+    if (!m.out){ perror("trace: salida"); return -1; }
+    for_each_dump(find_base, &m);
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", m.out);
+    for_each_dump(emit_dump, &m);
+    fputs("\n]}\n", m.out);
+    int rc = (fclose(m.out) == 0) ? 0 : -1;
+    if (rc != 0) perror("trace: salida");
+    fprintf(stderr, "trace: %s con %llu tramos de %d procesos", trace_path,
+            (unsigned long long)m.events, m.procs);
+    if (m.lost) fprintf(stderr, " (%llu perdidos por buffer lleno)", (unsigned long long)m.lost);
+    fputc('\n', stderr);
+    return rc;
+}
@@ -9,8 +9,11 @@
 #include <string.h>
 #include <ncurses.h>
 #include <getopt.h>
+#include <signal.h>
 #include "ipc.h"            // ipc_open_and_map_state/sync
 #include "rwsem.h"          // rw_reader_enter/exit
+#include "spinwait.h"       // espera adaptativa de A (CHOMP_SPIN)
+#include "trace.h"          // CHOMP_TRACE
 
 static void ensure_term(void){
     const char *t = getenv("TERM");
@@ -180,16 +183,66 @@ static void draw_ui(const state_t *st){
 // CLI
 static void usage(const char *p){
     fprintf(stderr, "Uso: %s [-w ancho -h alto]  o  %s ancho alto\n", p, p);
+    fprintf(stderr, "     %s -s   (espectador: se suma a una partida en curso, q para salir)\n", p);
+}
+
+// Copia local del estado para dibujar fuera del lock de lector: bajo el lock un solo memcpy
+// del segmento entero (una pasada secuencial, sin comparar contra copias viejas) y se dibuja
+// de la copia ya sin lock. Asi el master espera a lo sumo la copia y no un render de ncurses
+typedef struct {
+    state_t *buf;
+    size_t   size;
+} snapshot_t;
+
+static int snapshot_init(snapshot_t *sn, const state_t *st){
+    sn->size = ipc_state_size(st->width, st->height);
+    sn->buf = malloc(sn->size);
+    return sn->buf ? 0 : -1;
+}
+
+static void snapshot_free(snapshot_t *sn){
+    free(sn->buf);
+}
+
+// Llamar con el lock de lector tomado. Devuelve la copia lista para dibujar
+static const state_t *snapshot_take(snapshot_t *sn, const state_t *st){
+    memcpy(sn->buf, st, sn->size);
+    return sn->buf;
+}
+
+// Espectador (-s): sin handshake A/B. Copia el estado sin lock cada vez que cambia el epoch
+// de /game_ext y dibuja a su ritmo (si se atrasa saltea cuadros, el master no lo espera).
+// Puede entrar y salir en cualquier momento de la partida
+static void spectate(const state_t *st, sync_t *sy, frame_t *fr){
+    size_t size = ipc_state_size(st->width, st->height);
+    state_t *snap = malloc(size);
+    if (!snap){ perror("view: malloc"); return; }
+    nodelay(stdscr, TRUE);
+    bool quit = false;
+    while (!quit){
+        uint32_t last = frame_snapshot(fr, st, snap, size, sy);
+        draw_ui(snap);
+        if (snap->game_over) break;
+        // esperar el proximo cuadro; cada 200ms revisar el teclado y que el master siga vivo
+        uint32_t e;
+        while (!quit && ((e = frame_wait(fr, last, 200)) == last || (e & 1u))){
+            int ch = getch();
+            quit = (ch == 'q' || ch == 'Q') || (kill(fr->master_pid, 0) != 0 && errno == ESRCH);
+        }
+    }
+    free(snap);
 }
 
 
 int main(int argc, char **argv){
     unsigned short W = 0, H = 0;
+    bool spectator = false;
 
     // Parseo de parametros y fallback posicional
     int opt;
-    while ((opt = getopt(argc, argv, "w:h:")) != -1){
+    while ((opt = getopt(argc, argv, "w:h:s")) != -1){
         switch(opt){
+            case 's': spectator = true; break;
             case 'w': W = (unsigned short)strtoul(optarg, NULL, 10); break;
             case 'h': H = (unsigned short)strtoul(optarg, NULL, 10); break;
             default: usage(argv[0]); return 2;
@@ -200,7 +253,9 @@ int main(int argc, char **argv){
         W = (unsigned short)strtoul(argv[optind],     NULL, 10);
         H = (unsigned short)strtoul(argv[optind + 1], NULL, 10);
     }
-    if (W == 0 || H == 0){ usage(argv[0]); return 2; }
+    if (!spectator && (W == 0 || H == 0)){ usage(argv[0]); return 2; }
+
+    trace_init(spectator ? "espectador" : "vista");
 
     // Conexion a ambas shm
     state_t *st = ipc_open_and_map_state();
@@ -208,7 +263,24 @@ int main(int argc, char **argv){
     sync_t  *sy = ipc_open_and_map_sync();
     if (!sy){ perror("view: open sync"); ipc_unmap_state(st); return 1; }
 
-    if (st->width != W || st->height != H){
+    // el espectador necesita los cuadros de un master vivo
+    ext_header_t *ext = NULL;
+    frame_t *fr = NULL;
+    if (spectator){
+        ext = ipc_open_and_map_ext(true);        // RW: el espectador se anota en waiters
+        fr = ext_section(ext, EXT_SEC_FRAME, sizeof(frame_t));
+        if (!fr || kill(fr->master_pid, 0) != 0){
+            fprintf(stderr, "view: no hay una partida publicando cuadros (%s)\n", ipc_shm_name(SHM_EXT));
+            ipc_unmap_ext(ext); ipc_unmap_sync(sy); ipc_unmap_state(st);
+            return 1;
+        }
+    } else {
+        ext = ipc_open_and_map_ext(true);
+    }
+    // anotarse como lector del master que publico /game_ext (ver lockwatch.h)
+    lockwatch_t *lw = ext_section(ext, EXT_SEC_LOCKWATCH, sizeof(lockwatch_t));
+    if (lw && lw->master_pid == ext->master_pid) lockwatch_attach(lw, -1);
+    if (!spectator && (st->width != W || st->height != H)){
         fprintf(stderr, "view: advertencia: W/H recibidos (%u,%u) difieren de SHM (%u,%u)\n",
                 (unsigned)W,(unsigned)H,(unsigned)st->width,(unsigned)st->height);
     }
@@ -217,6 +289,7 @@ int main(int argc, char **argv){
     ensure_term();
     if (initscr() == NULL){
         fprintf(stderr, "view: no pude inicializar ncurses (TERM=%s)\n", getenv("TERM"));
+        ipc_unmap_ext(ext);
         ipc_unmap_sync(sy);
         ipc_unmap_state(st);
         return 1;
@@ -226,18 +299,50 @@ int main(int argc, char **argv){
     curs_set(0);
     if (has_colors()) init_colors();
 
+    if (spectator){
+        spectate(st, sy, fr);
+        endwin();
+        ipc_unmap_ext(ext);
+        ipc_unmap_sync(sy);
+        ipc_unmap_state(st);
+        return 0;
+    }
+
+    snapshot_t snap;
+    if (snapshot_init(&snap, st) != 0){
+        endwin();
+        perror("view: malloc");
+        ipc_unmap_ext(ext);
+        ipc_unmap_sync(sy);
+        ipc_unmap_state(st);
+        return 1;
+    }
+
     // Bucle A/B
+    spinwait_t spin;
+    spinwait_init(&spin);
     while (1){
-        sem_wait(&sy->A);           // 1. esperar pedido del master
-        rw_reader_enter(sy);        // 2. leer estado como lector
-        int over = st->game_over;
-        draw_ui(st);                // 3. dibujar ui completa
+        uint64_t t0 = trace_begin();
+        spinwait_sem(&spin, &sy->A);    // 1. esperar pedido del master (girando un poco si CHOMP_SPIN)
+        trace_end(TR_VIEW_WAIT, t0, -1);
+        t0 = trace_begin();
+        rw_reader_enter(sy);        // 2. copiar el estado como lector y soltar enseguida
+        const state_t *cur = snapshot_take(&snap, st);
         rw_reader_exit(sy);
-        sem_post(&sy->B);           // 4. notificar al master que termine de imprimir
-        if (over) break;            // salir si el juego termino
+        trace_end(TR_VIEW_COPY, t0, -1);
+        // 3. B apenas esta la copia: el master sigue mientras se dibuja. Si vuelve a postear A
+        // antes de que termine el render, ese cuadro se toma en la vuelta siguiente (A cuenta)
+        sem_post(&sy->B);
+        t0 = trace_begin();
+        draw_ui(cur);               // 4. dibujar ui completa desde la copia, sin lock ni master esperando
+        trace_end(TR_VIEW_RENDER, t0, -1);
+        if (cur->game_over) break;  // salir si el juego termino
     }
 
     endwin();
+    snapshot_free(&snap);
+    spinwait_report(&spin, "view");
+    ipc_unmap_ext(ext);
     ipc_unmap_sync(sy);
     ipc_unmap_state(st);
     return 0;